@@ -22,6 +22,7 @@
 #include "s4642286_CAG_display.h"
 #include "s4642286_oled.h"
 #include "s4642286_CAG_simulator.h"
+#include "s4642286_lta1000g.h"
 
 /**
  * @brief The controlling task for the CAG Display. This task will receive
@@ -69,7 +70,9 @@ void s4642286TaskCAGDisplay(void) {
 						}
 					}
 				}
+				LTA1000G_PROBE_START(PROBE_DISPLAY_FLUSH);
 				ssd1306_UpdateScreen();	
+				LTA1000G_PROBE_END(PROBE_DISPLAY_FLUSH);
         	}
 		}
 
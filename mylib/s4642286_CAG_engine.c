@@ -0,0 +1,202 @@
+ /**
+ **************************************************************
+ * @file mylib/s4642286_CAG_engine.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief CAG reference engine (hardware independent)
+ ***************************************************************
+ * EXTERNAL FUNCTIONS
+ ***************************************************************
+ * s4642286_CAG_engine_reset() - Sets every cell of a board to dead.
+ * s4642286_CAG_engine_add_life() - Places a cell or lifeform on a board.
+ * s4642286_CAG_engine_step() - Advances a board by one generation.
+ ***************************************************************
+ */
+
+#include "s4642286_CAG_engine.h"
+
+/**
+ * @brief Set a cell to dead or alive. Cells that fall outside the board are
+ * 		  ignored, so lifeforms placed near an edge are clipped to the board.
+ *
+ * @param board the board to modify.
+ * @param x the x coordinate of the cell.
+ * @param y the y coordinate of the cell.
+ * @param value 1 for alive or 0 for dead.
+ */
+static void set_cell(int board[SIMULATION_WIDTH][SIMULATION_HEIGHT], int x, int y, int value) {
+	if (x >= 0 && x < SIMULATION_WIDTH && y >= 0 && y < SIMULATION_HEIGHT) {
+		board[x][y] = value;
+	}
+}
+
+/**
+ * @brief Initialise/Reset a board and set all the cells to be empty.
+ *
+ * @param board the board to clear.
+ */
+void s4642286_CAG_engine_reset(int board[SIMULATION_WIDTH][SIMULATION_HEIGHT]) {
+	for (int x = 0; x < SIMULATION_WIDTH; x++) {
+		for (int y = 0; y < SIMULATION_HEIGHT; y++) {
+			// Initialise each cell to be empty.
+			board[x][y] = 0;
+		}
+	}
+}
+
+/**
+ * @brief Add a life form to a board. Any part of the life form that lies
+ * 		  outside the board is not drawn.
+ *
+ * @param board the board to add the life form to.
+ * @param type the type of life to add (CELL_DEAD, STILL_BLOCK, etc.)
+ * @param x the x coordinate of the life form anchor cell.
+ * @param y the y coordinate of the life form anchor cell.
+ */
+void s4642286_CAG_engine_add_life(int board[SIMULATION_WIDTH][SIMULATION_HEIGHT], int type, int x, int y) {
+	switch (type) {
+		case CELL_DEAD:
+			set_cell(board, x, y, 0);
+			break;
+
+		case CELL_ALIVE:
+			set_cell(board, x, y, 1);
+			break;
+
+		case STILL_BLOCK:
+			set_cell(board, x, y, 1);
+			set_cell(board, x + 1, y, 1);
+			set_cell(board, x, y + 1, 1);
+			set_cell(board, x + 1, y + 1, 1);
+			break;
+
+		case STILL_BEEHIVE:
+			set_cell(board, x - 1, y, 1);
+			set_cell(board, x, y - 1, 1);
+			set_cell(board, x + 1, y - 1, 1);
+			set_cell(board, x, y + 1, 1);
+			set_cell(board, x + 1, y + 1, 1);
+			set_cell(board, x + 2, y, 1);
+			break;
+
+		case STILL_LOAF:
+			set_cell(board, x - 1, y - 1, 1);
+			set_cell(board, x, y - 1, 1);
+			set_cell(board, x - 2, y, 1);
+			set_cell(board, x + 1, y, 1);
+			set_cell(board, x - 1, y + 1, 1);
+			set_cell(board, x + 1, y + 1, 1);
+			set_cell(board, x, y + 2, 1);
+			break;
+
+		case OSC_BLINKER:
+			set_cell(board, x, y, 1);
+			set_cell(board, x + 1, y, 1);
+			set_cell(board, x - 1, y, 1);
+			break;
+
+		case OSC_TOAD:
+			set_cell(board, x, y, 1);
+			set_cell(board, x + 1, y, 1);
+			set_cell(board, x - 1, y, 1);
+			set_cell(board, x, y + 1, 1);
+			set_cell(board, x + 1, y + 1, 1);
+			set_cell(board, x + 2, y + 1, 1);
+			break;
+
+		case OSC_BEACON:
+			set_cell(board, x - 1, y - 1, 1);
+			set_cell(board, x - 1, y - 2, 1);
+			set_cell(board, x, y - 2, 1);
+			set_cell(board, x + 1, y + 1, 1);
+			set_cell(board, x + 2, y + 1, 1);
+			set_cell(board, x + 2, y, 1);
+			break;
+
+		case SPACESHIP_GLIDER:
+			set_cell(board, x, y, 1);
+			set_cell(board, x - 1, y - 1, 1);
+			set_cell(board, x + 1, y, 1);
+			set_cell(board, x - 1, y + 1, 1);
+			set_cell(board, x, y + 1, 1);
+			break;
+	}
+}
+
+/**
+ * @brief Updates the state of every cell on a board to dead or alive based on
+ * 		  the rules of cellular evolution. This is the reference kernel that any
+ * 		  faster engine must match.
+ * 		  -> This algorithm was based on the code written by Joan Soler-Adillon.
+ *
+ * @param board the board to advance by one generation.
+ * @param scratch a board sized buffer used to record the previous generation.
+ */
+void s4642286_CAG_engine_step(int board[SIMULATION_WIDTH][SIMULATION_HEIGHT],
+		int scratch[SIMULATION_WIDTH][SIMULATION_HEIGHT]) {
+	// Save current cell layout to the scratch buffer.
+	for (int x = 0; x < SIMULATION_WIDTH; x++) {
+		for (int y = 0; y < SIMULATION_HEIGHT; y++) {
+			scratch[x][y] = board[x][y];
+		}
+	}
+
+	// Check the current state of each cell and compare with the rules of cellular evolution.
+	for (int x = 0; x < SIMULATION_WIDTH; x++) {
+		for (int y = 0; y < SIMULATION_HEIGHT; y++) {
+			// Create a variable for number of neighbours surrounding each cell.
+			int numNeighbours = 0;
+
+			for (int xx = x - 1; xx <= x + 1; xx++) {
+				for (int yy = y - 1; yy <= y + 1; yy++) {
+
+					// Ensure that cell is within the bounds of the simulation
+					if (((xx >= 0) && (xx < SIMULATION_WIDTH)) &&((yy >= 0) && (yy < SIMULATION_HEIGHT))) {
+
+						// Check that we are not referring to the current cell being checked.
+						if (!((xx == x) && (yy == y))) {
+
+							// If the neighbouring cell is alive, add it to the count.
+							if (scratch[xx][yy] == 1){
+								numNeighbours++;
+							}
+						}
+					}
+				}
+			}
+
+			// Using information about surrounding cells, apply rules of cellular evolution.
+			if (scratch[x][y] == 1) {
+				// The cell is currently alive, we need to kill it if necessary.
+				if (numNeighbours < 2 || numNeighbours > 3) {
+					// Kill the cell due to lack of alive neighbours surrounding it.
+					board[x][y] = 0;
+				}
+			} else {
+				// The cell is currently dead, we need to make it live if it has 3 living neighbours.
+				if (numNeighbours == 3) {
+					board[x][y] = 1;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Counts the living cells on a board.
+ *
+ * @param board the board to count.
+ * @return int the number of living cells (0 to SIMULATION_WIDTH * SIMULATION_HEIGHT).
+ */
+int s4642286_CAG_engine_population(int board[SIMULATION_WIDTH][SIMULATION_HEIGHT]) {
+	int population = 0;
+
+	for (int x = 0; x < SIMULATION_WIDTH; x++) {
+		for (int y = 0; y < SIMULATION_HEIGHT; y++) {
+			if (board[x][y] == 1) {
+				population++;
+			}
+		}
+	}
+	return population;
+}
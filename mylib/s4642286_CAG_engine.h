@@ -0,0 +1,50 @@
+ /**
+ **************************************************************
+ * @file mylib/s4642286_CAG_engine.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief CAG reference engine (hardware independent)
+ ***************************************************************
+ * EXTERNAL FUNCTIONS
+ ***************************************************************
+ * s4642286_CAG_engine_reset() - Sets every cell of a board to dead.
+ * s4642286_CAG_engine_add_life() - Places a cell or lifeform on a board.
+ * s4642286_CAG_engine_step() - Advances a board by one generation.
+ * s4642286_CAG_engine_population() - Counts the living cells on a board.
+ ***************************************************************
+ */
+
+#ifndef S4642286_CAG_ENGINE_H
+#define S4642286_CAG_ENGINE_H
+
+#define OLED_WIDTH 128  // In Pixels
+#define OLED_HEIGHT 32  // In Pixels
+#define SIMULATION_WIDTH (OLED_WIDTH / CELL_SIZE)
+#define SIMULATION_HEIGHT (OLED_HEIGHT / CELL_SIZE)
+#define CELL_SIZE 2
+
+// Define Type values
+#define CELL_DEAD 0x10
+#define CELL_ALIVE 0x11
+#define STILL_BLOCK 0x20
+#define STILL_BEEHIVE 0x21
+#define STILL_LOAF 0x22
+#define OSC_BLINKER 0x30
+#define OSC_TOAD 0x31
+#define OSC_BEACON 0x32
+#define SPACESHIP_GLIDER 0x40
+
+/*
+ * The engine only depends on the C language so that it can be compiled on a
+ * host machine and compared generation by generation against other engines.
+ * Boards are indexed as board[x][y], with 1 for a living cell and 0 otherwise.
+ */
+
+// External Function Definitions
+extern void s4642286_CAG_engine_reset(int board[SIMULATION_WIDTH][SIMULATION_HEIGHT]);
+extern void s4642286_CAG_engine_add_life(int board[SIMULATION_WIDTH][SIMULATION_HEIGHT], int type, int x, int y);
+extern void s4642286_CAG_engine_step(int board[SIMULATION_WIDTH][SIMULATION_HEIGHT],
+		int scratch[SIMULATION_WIDTH][SIMULATION_HEIGHT]);
+extern int s4642286_CAG_engine_population(int board[SIMULATION_WIDTH][SIMULATION_HEIGHT]);
+
+#endif
@@ -137,6 +137,7 @@ void s4642286TaskCAGGrid(void) {
 				// Send current cursor position to LED Bar.
 				if (positionQueue != NULL) {
 					positionSend.value = (xpos << 4 | ypos);
+					positionSend.max = 0;
 					xQueueSendToFront(positionQueue, ( void * ) &positionSend, ( portTickType ) 10);
 				}
 			}
@@ -19,20 +19,193 @@
 #include "s4642286_joystick.h"
 #include "s4642286_CAG_joystick.h"
 #include "s4642286_CAG_simulator.h"
+#include "s4642286_CAG_grid.h"
+#include "s4642286_lta1000g.h"
+
+/* Joystick zones are separated by these thresholds. Each zone sets the event
+ * bits below when it is entered (zones with no bits are deadzones). */
+static const int xThresholds[] = { XY_MIN, XY_MAX };
+static const EventBits_t xZoneBits[] = {
+	STOP_SIM,           // Extreme minimum, pause simulation
+	0,
+	START_SIM           // Extreme maximum, start simulation
+};
+
+static const int yThresholds[] = { XY_MIN, XY_MID_LOW, XY_MID_HIGH, XY_MAX };
+static const EventBits_t yZoneBits[] = {
+	UPDATE_SPEED_1,     // Extreme minimum, set simulation time to 1s
+	0,
+	UPDATE_SPEED_2,     // Upright, set simulation time to 2s
+	UPDATE_SPEED_5,     // Nearly at maximum, set simulation time to 5s
+	UPDATE_SPEED_10     // Extreme maximum, set simulation time to 10s
+};
+
+// Lifeforms that can be stamped in cursor mode, in the order they are selected.
+static const int stampTypes[] = {
+	CELL_ALIVE, STILL_BLOCK, STILL_BEEHIVE, STILL_LOAF,
+	OSC_BLINKER, OSC_TOAD, OSC_BEACON, SPACESHIP_GLIDER
+};
+
+// Cursor position in 1/256ths of a cell, so slow movements accumulate.
+static int cursorX, cursorY;
+
+// Stamps waiting to be sent to SimQueue, and the number already sent.
+static caMessage_t stampBatch[STAMP_BATCH_SIZE];
+static int stampCount, stampSent;
+
+/**
+ * @brief Finds the zone of a joystick value. The zone only changes once the
+ * 		  value is more than XY_HYSTERESIS past a threshold, so noise around a
+ * 		  threshold does not cause repeated changes.
+ * 
+ * @param value the joystick value.
+ * @param zone the current zone, or -1 if there is none yet.
+ * @param thresholds the thresholds between zones, in ascending order.
+ * @param numThresholds the number of thresholds.
+ * @return int the new zone (0 to numThresholds).
+ */
+static int cag_joystick_zone(int value, int zone, const int *thresholds, int numThresholds) {
+	if (zone < 0) {
+		// No zone yet, so use the thresholds without hysteresis.
+		zone = 0;
+		while (zone < numThresholds && value > thresholds[zone]) {
+			zone++;
+		}
+		return zone;
+	}
+
+	while (zone > 0 && value < thresholds[zone - 1] - XY_HYSTERESIS) {
+		zone--;
+	}
+	while (zone < numThresholds && value > thresholds[zone] + XY_HYSTERESIS) {
+		zone++;
+	}
+	return zone;
+}
+
+/**
+ * @brief Converts a joystick value to a deflection from the centre, with the
+ * 		  deadzone removed.
+ * 
+ * @param value the joystick value.
+ * @return int the deflection (0 inside the deadzone).
+ */
+static int cag_joystick_deflection(int value) {
+	int deflection = value - XY_CENTRE;
+
+	if (deflection > CURSOR_DEADZONE) {
+		return deflection - CURSOR_DEADZONE;
+	} else if (deflection < -CURSOR_DEADZONE) {
+		return deflection + CURSOR_DEADZONE;
+	}
+	return 0;
+}
+
+/**
+ * @brief Moves the grid cursor with a velocity proportional to the joystick
+ * 		  deflection, and sends the new position to the LED bar when the
+ * 		  cursor moves to another cell.
+ * 
+ * @param x the joystick x value.
+ * @param y the joystick y value (pushing up moves the cursor up).
+ * @param ms the time since the cursor was last moved.
+ */
+static void cag_joystick_cursor_move(int x, int y, int ms) {
+	xyposition positionSend;
+	int newX, newY;
+
+	cursorX += cag_joystick_deflection(x) * ms * CURSOR_MAX_SPEED * 256 / (XY_RANGE * 1000);
+	cursorY -= cag_joystick_deflection(y) * ms * CURSOR_MAX_SPEED * 256 / (XY_RANGE * 1000);
+
+	// Keep the cursor on the board.
+	if (cursorX < 0) {
+		cursorX = 0;
+	} else if (cursorX >= SIMULATION_WIDTH * 256) {
+		cursorX = SIMULATION_WIDTH * 256 - 1;
+	}
+	if (cursorY < 0) {
+		cursorY = 0;
+	} else if (cursorY >= SIMULATION_HEIGHT * 256) {
+		cursorY = SIMULATION_HEIGHT * 256 - 1;
+	}
+
+	newX = cursorX >> 8;
+	newY = cursorY >> 8;
+
+	if (newX != xpos || newY != ypos) {
+		xpos = newX;
+		ypos = newY;
+
+		// Send current cursor position to LED Bar.
+		if (positionQueue != NULL) {
+			positionSend.value = (xpos << 4 | ypos);
+			positionSend.max = 0;
+			xQueueSendToFront(positionQueue, ( void * ) &positionSend, ( portTickType ) 10);
+		}
+	}
+}
+
+/**
+ * @brief Adds a stamp of a lifeform at the cursor to the batch. The stamp is
+ * 		  dropped if the batch is full.
+ * 
+ * @param type the lifeform type.
+ */
+static void cag_joystick_stamp_add(int type) {
+	if (stampCount < STAMP_BATCH_SIZE) {
+		stampBatch[stampCount].cell_x = xpos;
+		stampBatch[stampCount].cell_y = ypos;
+		stampBatch[stampCount].type = type;
+		stampCount++;
+	}
+}
+
+/**
+ * @brief Sends the waiting stamps to SimQueue, as many as there is space for,
+ * 		  without blocking. The rest are sent on a later pass.
+ * 
+ */
+static void cag_joystick_stamp_flush(void) {
+	if (SimQueue == NULL) {
+		return;
+	}
+
+	while (stampSent < stampCount &&
+			xQueueSendToBack(SimQueue, ( void * ) &stampBatch[stampSent], ( portTickType ) 0) == pdPASS) {
+		stampSent++;
+	}
+
+	if (stampSent == stampCount) {
+		stampCount = 0;
+		stampSent = 0;
+	}
+}
 
 /**
  * @brief The controlling task for the CAG Joystick. This function will
  * 		  control the simulation update time of the CAG simulator as well
- * 		  as pausing, resetting and clearing the simulation.
+ * 		  as pausing, resetting and clearing the simulation. Event bits are
+ * 		  only set when the joystick moves into a new zone.
+ * 		  -> A long press toggles cursor mode, where the joystick moves the
+ * 		  grid cursor instead, a short press stamps the selected lifeform at
+ * 		  the cursor and a medium press selects the next lifeform. Stamps are
+ * 		  batched and sent to SimQueue as space allows. Outside cursor mode,
+ * 		  any shorter press stops and clears the simulation.
  *  
  */
 void s4642286TaskCAGJoystick(void) {
-	// Variables to store x and y position of joystick.
-	int x, y;
+	// Current zone of the joystick x and y positions.
+	int xZone = -1, yZone = -1, zone;
+
+	// Latest joystick position, cursor mode and the selected lifeform.
+	int x = XY_CENTRE, y = XY_CENTRE;
+	int cursorMode = 0, stampType = 0;
+	uint32_t pressDuration;
+	TickType_t lastTick = xTaskGetTickCount(), tick;
 	
-	// Create queue to receive joystick postions.
+	// Create queue to receive joystick postions (only the latest is kept).
 	JoystickValues joystickRecieve;
-	JoystickQueue = xQueueCreate(10, sizeof(joystickRecieve));
+	JoystickQueue = xQueueCreate(1, sizeof(joystickRecieve));
 
 	// Cyclic Executive (CE) loop
 	for (;;) {
@@ -41,42 +214,62 @@ void s4642286TaskCAGJoystick(void) {
 				x = joystickRecieve.x_joystick;
 				y = joystickRecieve.y_joystick;
 
-				// Check x value.
-				if (x < XY_MIN) {
-					// Joystick x signal is at extreme minimum. Thus, pause simulation.
-					xEventGroupSetBits(specialFunctions, STOP_SIM);
+				// Check x value (zones are tracked but not acted on in cursor mode).
+				zone = cag_joystick_zone(x, xZone, xThresholds,
+					sizeof(xThresholds) / sizeof(xThresholds[0]));
 
-				} else if (x > XY_MAX) {
-					// Joystick x signal is at extreme maximum. Thus, start simulation.
-					xEventGroupSetBits(specialFunctions, START_SIM);
+				if (zone != xZone && xZoneBits[zone] != 0 && !cursorMode) {
+					xEventGroupSetBits(specialFunctions, xZoneBits[zone]);
 				}
+				xZone = zone;
 
 				// Check y value.
-				if (y < XY_MIN) {
-					// Joystick y signal is at extreme minimum. Thus, set simulation time to 1s.
-					xEventGroupSetBits(specialFunctions, UPDATE_SPEED_1);
-
-				} else if (y > XY_MAX) {
-					// Joystick y signal is at extreme maximum. Thus, set simulation time to 10s.
-					xEventGroupSetBits(specialFunctions, UPDATE_SPEED_10);
-
-				} else if (y > XY_MID_LOW && y < XY_MID_HIGH){
-					// Joystick y signal is upright, thus, set simulation time to 2s.
-					xEventGroupSetBits(specialFunctions, UPDATE_SPEED_2);
-				
-				} else if (y > XY_MID_HIGH && y < XY_MAX){
-					// Joystick y signal is nearly at maximum, thus, set simulation time to 5s.
-					xEventGroupSetBits(specialFunctions, UPDATE_SPEED_5);
-				
+				zone = cag_joystick_zone(y, yZone, yThresholds,
+					sizeof(yThresholds) / sizeof(yThresholds[0]));
+
+				if (zone != yZone && yZoneBits[zone] != 0 && !cursorMode) {
+					xEventGroupSetBits(specialFunctions, yZoneBits[zone]);
 				}
+				yZone = zone;
 			}
 		}
 
+		// The joystick only sends changes, so keep moving with the latest position.
+		tick = xTaskGetTickCount();
+		if (cursorMode) {
+			cag_joystick_cursor_move(x, y, tick - lastTick);      // 1 tick is 1ms
+		}
+		lastTick = tick;
+
+		cag_joystick_stamp_flush();
+
 		if( xSemaphoreTake( pbSem, 10 ) == pdTRUE ) {
-			// Joystick Pushbutton pressed, so clear display and reset simulator.
-			xEventGroupSetBits(specialFunctions, STOP_SIM);
-			xEventGroupSetBits(specialFunctions, CLEAR_GRID);
-			xEventGroupClearBits(specialFunctions, UPDATE_SPEED_2);
+			pressDuration = s4642286_reg_joystick_press_duration_get();
+
+			if (pressDuration >= PRESS_LONG) {
+				/* Toggle cursor mode, starting from the current cursor cell. The
+				 * cursor stays still until a joystick value arrives in the new
+				 * mode, as the press itself can deflect the stick. */
+				cursorMode = !cursorMode;
+				cursorX = (xpos << 8) + 128;
+				cursorY = (ypos << 8) + 128;
+				x = XY_CENTRE;
+				y = XY_CENTRE;
+
+			} else if (cursorMode && pressDuration >= PRESS_MEDIUM) {
+				// Select the next lifeform to stamp.
+				stampType = (stampType + 1) % (sizeof(stampTypes) / sizeof(stampTypes[0]));
+
+			} else if (cursorMode) {
+				// Stamp the selected lifeform at the cursor.
+				cag_joystick_stamp_add(stampTypes[stampType]);
+
+			} else {
+				// Joystick Pushbutton pressed, so clear display and reset simulator.
+				xEventGroupSetBits(specialFunctions, STOP_SIM);
+				xEventGroupSetBits(specialFunctions, CLEAR_GRID);
+				xEventGroupClearBits(specialFunctions, UPDATE_SPEED_2);
+			}
         }
 		
 		// Delay the task for 10ms.
@@ -29,12 +29,31 @@ extern void s4642286_tsk_CAGJoystick_init(void);
 #define XY_MID_LOW 2030
 #define XY_MID_HIGH 2080
 
+// A value must pass a threshold by this much before the zone changes.
+#define XY_HYSTERESIS 8
+
+// Centre and range of the joystick values, used for the cursor.
+#define XY_CENTRE ((XY_MID_LOW + XY_MID_HIGH) / 2)
+#define XY_RANGE 2048
+
+// Cursor mode: deflections smaller than the deadzone do not move the cursor,
+// and a full deflection moves it CURSOR_MAX_SPEED cells per second.
+#define CURSOR_DEADZONE 100
+#define CURSOR_MAX_SPEED 32
+
+// Joystick press durations (ms). Shorter presses stamp (cursor mode) or clear.
+#define PRESS_MEDIUM 500    // Select the next lifeform to stamp (cursor mode)
+#define PRESS_LONG 1000     // Toggle cursor mode
+
+// Stamps that can wait to be sent to SimQueue.
+#define STAMP_BATCH_SIZE 16
+
 typedef struct {
     int x_joystick;
     int y_joystick;
 } JoystickValues;
 
-// The queue for sending joystick information to simulation.
+// The queue for sending joystick information to simulation (1 deep, written with xQueueOverwrite).
 QueueHandle_t JoystickQueue;
 
 // Create a task handle for the Joystick.
@@ -22,6 +22,7 @@
 #include "s4642286_CAG_mnemonic.h"
 #include "s4642286_CAG_simulator.h"
 #include "s4642286_cli_CAG_mnemonic.h"
+#include "s4642286_lta1000g.h"
 
 
 /**
@@ -37,12 +38,19 @@ void s4642286TaskCAGMnemonic(void) {
 	char *pcOutputString;
 	BaseType_t xReturned;
 	int mnemonicOn = 0;
+	uint32_t startCycles, elapsedCycles;
 
 	/* Register CLI commands */
 	s4642286_cli_init();
 
 	hardware_init();
 
+	/* Enable the DWT cycle counter used to time the CLI command path. */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	memset(&cliStats, 0, sizeof(cliStats));
+
 	/* Initialise pointer to CLI output buffer. */
 	memset(cInputString, 0, sizeof(cInputString));
 	pcOutputString = FreeRTOS_CLIGetOutputBuffer();
@@ -81,19 +89,39 @@ void s4642286TaskCAGMnemonic(void) {
 					/* Process command input string. */
 					while (xReturned != pdFALSE) {
 
+						/* The probe covers the process and output work of each
+						 * chunk, not the task delay after it. */
+						LTA1000G_PROBE_START(PROBE_CLI_COMMAND);
+
 						/* Returns pdFALSE, when all strings have been returned */
+						startCycles = DWT->CYCCNT;
 						xReturned = FreeRTOS_CLIProcessCommand( cInputString, pcOutputString, configCOMMAND_INT_MAX_OUTPUT_SIZE );
+						elapsedCycles = DWT->CYCCNT - startCycles;
+
+						cliStats.processCycles += elapsedCycles;
+						if (elapsedCycles > cliStats.maxProcessCycles) {
+							cliStats.maxProcessCycles = elapsedCycles;
+						}
 
 						/* Display CLI command output string (not thread safe) */
 						portENTER_CRITICAL();
+						startCycles = DWT->CYCCNT;
 						for (i = 0; i < (int) strlen(pcOutputString); i++) {
 							debug_putc(*(pcOutputString + i));
 						}
+						elapsedCycles = DWT->CYCCNT - startCycles;
 						portEXIT_CRITICAL();
+						LTA1000G_PROBE_END(PROBE_CLI_COMMAND);
+
+						cliStats.outputChars += i;
+						if (elapsedCycles > cliStats.maxCriticalCycles) {
+							cliStats.maxCriticalCycles = elapsedCycles;
+						}
 
 						vTaskDelay(5);
 					}
 
+					cliStats.commands++;
 					memset(cInputString, 0, sizeof(cInputString));
 					InputIndex = 0;
 
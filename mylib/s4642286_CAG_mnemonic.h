@@ -25,5 +25,21 @@ extern void s4642286_tsk_CAGMnemonic_init(void);
 
 #define DELETE_CHAR 127
 
+/**
+ * @brief A struct for the CLI command path timing statistics. All times are
+ * 		  in CPU cycles, measured with the DWT cycle counter.
+ * 
+ */
+typedef struct {
+    unsigned long commands;             // Number of command strings processed
+    unsigned long long processCycles;   // Total cycles spent in FreeRTOS_CLIProcessCommand
+    unsigned long maxProcessCycles;     // Longest single FreeRTOS_CLIProcessCommand call
+    unsigned long maxCriticalCycles;    // Longest interrupt-disabled output loop
+    unsigned long outputChars;          // Number of characters written to the console
+} cliStats_t;
+
+// Timing statistics for the CLI command path (reported by the clistat command).
+cliStats_t cliStats;
+
 
 #endif
\ No newline at end of file
@@ -20,6 +20,8 @@
 #include "event_groups.h"
 #include "s4642286_CAG_simulator.h"
 #include "s4642286_CAG_display.h"
+#include "s4642286_CAG_engine.h"
+#include "s4642286_lta1000g.h"
 
 // Function Definitions
 void check_special(void);
@@ -190,73 +192,7 @@ void update_display(void) {
  * @param life the coordinates and the type of life to add.
  */
 void add_life(caMessage_t life) {
-	switch (life.type) {
-		case CELL_DEAD:
-			cells[life.cell_x][life.cell_y] = 0;
-			break;
-
-		case CELL_ALIVE:
-			cells[life.cell_x][life.cell_y] = 1;
-			break;
-
-		case STILL_BLOCK:
-			cells[life.cell_x][life.cell_y] = 1;
-			cells[life.cell_x + 1][life.cell_y] = 1;
-			cells[life.cell_x][life.cell_y + 1] = 1;
-			cells[life.cell_x + 1][life.cell_y + 1] = 1;
-			break;
-
-		case STILL_BEEHIVE:
-			cells[life.cell_x - 1][life.cell_y] = 1;
-			cells[life.cell_x][life.cell_y - 1] = 1;
-			cells[life.cell_x + 1][life.cell_y - 1] = 1;
-			cells[life.cell_x][life.cell_y + 1] = 1;
-			cells[life.cell_x + 1][life.cell_y + 1] = 1;
-			cells[life.cell_x + 2][life.cell_y] = 1;
-			break;
-
-		case STILL_LOAF:
-			cells[life.cell_x - 1][life.cell_y - 1] = 1;
-			cells[life.cell_x][life.cell_y - 1] = 1;
-			cells[life.cell_x - 2][life.cell_y] = 1;
-			cells[life.cell_x + 1][life.cell_y] = 1;
-			cells[life.cell_x - 1][life.cell_y + 1] = 1;
-			cells[life.cell_x + 1][life.cell_y + 1] = 1;
-			cells[life.cell_x][life.cell_y + 2] = 1;
-			break;
-
-		case OSC_BLINKER:
-			cells[life.cell_x][life.cell_y] = 1;
-			cells[life.cell_x + 1][life.cell_y] = 1;
-			cells[life.cell_x - 1][life.cell_y] = 1;
-			break;
-
-		case OSC_TOAD:
-			cells[life.cell_x][life.cell_y] = 1;
-			cells[life.cell_x + 1][life.cell_y] = 1;
-			cells[life.cell_x - 1][life.cell_y] = 1;
-			cells[life.cell_x][life.cell_y + 1] = 1;
-			cells[life.cell_x + 1][life.cell_y + 1] = 1;
-			cells[life.cell_x + 2][life.cell_y + 1] = 1;
-			break;
-			
-		case OSC_BEACON:
-			cells[life.cell_x - 1][life.cell_y - 1] = 1;
-			cells[life.cell_x - 1][life.cell_y - 2] = 1;
-			cells[life.cell_x][life.cell_y - 2] = 1;
-			cells[life.cell_x + 1][life.cell_y + 1] = 1;
-			cells[life.cell_x + 2][life.cell_y + 1] = 1;
-			cells[life.cell_x + 2][life.cell_y] = 1;
-			break;
-
-		case SPACESHIP_GLIDER:
-			cells[life.cell_x][life.cell_y] = 1;
-			cells[life.cell_x - 1][life.cell_y - 1] = 1;
-			cells[life.cell_x + 1][life.cell_y] = 1;
-			cells[life.cell_x - 1][life.cell_y + 1] = 1;
-			cells[life.cell_x][life.cell_y + 1] = 1;
-			break;	
-	}
+	s4642286_CAG_engine_add_life(cells, life.type, life.cell_x, life.cell_y);
 }
 
 /**
@@ -264,66 +200,26 @@ void add_life(caMessage_t life) {
  * 
  */
 void reset_simulation(void) {
-	for (int x = 0; x < SIMULATION_WIDTH; x++) {
-		for (int y = 0; y < SIMULATION_HEIGHT; y++) {
-			// Initialise each cell to be empty.
-			cells[x][y] = 0;
-		}
-	}
+	s4642286_CAG_engine_reset(cells);
 }
 
 /**
  * @brief Runs at each simulation clock tick, and updates the current state of the
- * 		  cells to dead or alive based on the rules of cellular evolution.
- * 		  -> This algorithm was based on the code written by Joan Soler-Adillon.
+ * 		  cells to dead or alive based on the rules of cellular evolution. The
+ * 		  new population is sent to the LED Bar as a bar graph.
  * 
  */
 void update_simulation(void) {
-	// Save current cell layout to cell buffer.
-	for (int x = 0; x < SIMULATION_WIDTH; x++) {
-		for (int y = 0; y < SIMULATION_HEIGHT; y++) {
-			cellsBuffer[x][y] = cells[x][y];
-		}
-	}
+	xyposition populationSend;
 
-	// Check the current state of each cell and compare with the rules of cellular evolution.
-	for (int x = 0; x < SIMULATION_WIDTH; x++) {
-		for (int y = 0; y < SIMULATION_HEIGHT; y++) {
-			// Create a variable for number of neighbours surrounding each cell.
-			int numNeighbours = 0;
-
-			for (int xx = x - 1; xx <= x + 1; xx++) {
-				for (int yy = y - 1; yy <= y + 1; yy++) {
-
-					// Ensure that cell is within the bounds of the simulation
-					if (((xx >= 0) && (xx < SIMULATION_WIDTH)) &&((yy >= 0) && (yy < SIMULATION_HEIGHT))) {
-
-						// Check that we are not referring to the current cell being checked.	
-						if (!((xx == x) && (yy == y))) {
+	LTA1000G_PROBE_START(PROBE_SIM_GENERATION);
+	s4642286_CAG_engine_step(cells, cellsBuffer);
+	LTA1000G_PROBE_END(PROBE_SIM_GENERATION);
 
-							// If the neighbouring cell is alive, add it to the count.
-							if (cellsBuffer[xx][yy] == 1){
-								numNeighbours++;
-							}
-						}
-					}
-				}
-			}
-			
-			// Using information about surrounding cells, apply rules of cellular evolution.
-			if (cellsBuffer[x][y] == 1) {
-				// The cell is currently alive, we need to kill it if necessary.
-				if (numNeighbours < 2 || numNeighbours > 3) {
-					// Kill the cell due to lack of alive neighbours surrounding it.
-					cells[x][y] = 0;
-				}
-			} else {
-				// The cell is currently dead, we need to make it live if it has 3 living neighbours. 
-				if (numNeighbours == 3) {
-					cells[x][y] = 1;
-				}
-			}
-		}
+	if (positionQueue != NULL) {
+		populationSend.value = s4642286_CAG_engine_population(cells);
+		populationSend.max = SIMULATION_WIDTH * SIMULATION_HEIGHT;
+		xQueueSendToBack(positionQueue, ( void * ) &populationSend, ( portTickType ) 0);
 	}
 }
 
@@ -16,6 +16,7 @@
 
 #include "semphr.h"
 #include "event_groups.h"
+#include "s4642286_CAG_engine.h"
 
 // External Function Definitions
 extern void s4642286_tsk_CAGSimulator_init(void);
@@ -71,15 +72,4 @@ EventGroupHandle_t specialFunctions;
 #define UPDATE_SPEED_10     1 << 6      // Update the simulation speed to 10s
 #define CONTROL_BITS 0x7F
 
-// Define Type values
-#define CELL_DEAD 0x10
-#define CELL_ALIVE 0x11
-#define STILL_BLOCK 0x20
-#define STILL_BEEHIVE 0x21
-#define STILL_LOAF 0x22
-#define OSC_BLINKER 0x30
-#define OSC_TOAD 0x31
-#define OSC_BEACON 0x32
-#define SPACESHIP_GLIDER 0x40
-
 #endif
\ No newline at end of file
@@ -19,6 +19,8 @@
 #include "FreeRTOS_CLI.h"
 #include "s4642286_CAG_joystick.h"
 #include "s4642286_CAG_simulator.h"
+#include "s4642286_CAG_mnemonic.h"
+#include "s4642286_hamming_pipeline.h"
 #include "s4642286_cli_CAG_mnemonic.h"
 
 /** CAG Mnemonic CLI Function Definitions. */
@@ -104,12 +106,36 @@ CLI_Command_Definition_t xUsage = {
 	0								
 };
 
+// Heap Command
+CLI_Command_Definition_t xHeap = {
+	"heap",
+	"heap: Show the free heap, the minimum ever free heap and the stack high water-mark of each task in bytes.\r\n",
+	prvHeapCommand,
+	0
+};
+
+// Clistat Command
+CLI_Command_Definition_t xCliStat = {
+	"clistat",
+	"clistat: Show the number of commands processed, the command processing time and the longest interrupt-disabled output time.\r\n",
+	prvCliStatCommand,
+	0
+};
+
+// Hamstat Command
+CLI_Command_Definition_t xHamStat = {
+	"hamstat",
+	"hamstat: Show the Hamming pipeline mode, the bytes received and sent (total and per second), the decoding errors, the transmit timeouts and the bytes lost to receive overruns.\r\n",
+	prvHamStatCommand,
+	0
+};
+
 
 /*
  *Private helper function for checking argument validity.
  */
 int check_values(int x, int y) {
-	if (x < 0 || x > SIMULATION_WIDTH || y < 0 || y > SIMULATION_HEIGHT) {
+	if (x < 0 || x >= SIMULATION_WIDTH || y < 0 || y >= SIMULATION_HEIGHT) {
 		return 0;
 	}
 	return 1;
@@ -123,11 +149,12 @@ static BaseType_t prvStillCommand(char *pcWriteBuffer, size_t xWriteBufferLen, c
 	const char *type;
 	const char *xpos;
 	const char *ypos;
+	BaseType_t paramLength;
 
 	/* Get parameters from command string */
-	type = FreeRTOS_CLIGetParameter(pcCommandString, 1, NULL);
-	xpos = FreeRTOS_CLIGetParameter(pcCommandString, 2, NULL);
-	ypos = FreeRTOS_CLIGetParameter(pcCommandString, 3, NULL);
+	type = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLength);
+	xpos = FreeRTOS_CLIGetParameter(pcCommandString, 2, &paramLength);
+	ypos = FreeRTOS_CLIGetParameter(pcCommandString, 3, &paramLength);
 
 	/* Send command to CAG Simulator. */
 	caMessage_t sendCommand;
@@ -161,11 +188,12 @@ static BaseType_t prvOscCommand(char *pcWriteBuffer, size_t xWriteBufferLen, con
 	const char *type;
 	const char *xpos;
 	const char *ypos;
+	BaseType_t paramLength;
 
 	/* Get parameters from command string */
-	type = FreeRTOS_CLIGetParameter(pcCommandString, 1, NULL);
-	xpos = FreeRTOS_CLIGetParameter(pcCommandString, 2, NULL);
-	ypos = FreeRTOS_CLIGetParameter(pcCommandString, 3, NULL);
+	type = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLength);
+	xpos = FreeRTOS_CLIGetParameter(pcCommandString, 2, &paramLength);
+	ypos = FreeRTOS_CLIGetParameter(pcCommandString, 3, &paramLength);
 
 	/* Send command to CAG Simulator. */
 	caMessage_t sendCommand;
@@ -198,10 +226,11 @@ static BaseType_t prvGliderCommand(char *pcWriteBuffer, size_t xWriteBufferLen,
 
 	const char *xpos;
 	const char *ypos;
+	BaseType_t paramLength;
 
 	/* Get parameters from command string */
-	xpos = FreeRTOS_CLIGetParameter(pcCommandString, 1, NULL);
-	ypos = FreeRTOS_CLIGetParameter(pcCommandString, 2, NULL);
+	xpos = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLength);
+	ypos = FreeRTOS_CLIGetParameter(pcCommandString, 2, &paramLength);
 
 	/* Send command to CAG Simulator. */
 	caMessage_t sendCommand;
@@ -276,10 +305,11 @@ static BaseType_t prvClearCommand(char *pcWriteBuffer, size_t xWriteBufferLen, c
 static BaseType_t prvDelCommand(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString ) {
 
 	const char *input;
+	BaseType_t paramLength;
 	int type;
 
 	/* Get parameters from command string */
-	input = FreeRTOS_CLIGetParameter(pcCommandString, 1, NULL);
+	input = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLength);
 
 	type = atoi(input);
 
@@ -309,10 +339,11 @@ static BaseType_t prvDelCommand(char *pcWriteBuffer, size_t xWriteBufferLen, con
 static BaseType_t prvCreCommand(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString ) {
 
 	const char *input;
+	BaseType_t paramLength;
 	int type;
 
 	/* Get parameters from command string */
-	input = FreeRTOS_CLIGetParameter(pcCommandString, 1, NULL);
+	input = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLength);
 
 	type = atoi(input);
 
@@ -373,6 +404,82 @@ static BaseType_t prvUsageCommand(char *pcWriteBuffer, size_t xWriteBufferLen, c
 	return pdFALSE;
 }
 
+/*
+ * Heap Command.
+ */
+static BaseType_t prvHeapCommand(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString ) {
+
+	TaskStatus_t *taskStatus;
+	UBaseType_t numTasks, i;
+	int length;
+
+	/* Write the heap usage to the write buffer. */
+	length = snprintf((char *) pcWriteBuffer, xWriteBufferLen, "heap free: %u\r\nheap min free: %u\r\n",
+		(unsigned int) xPortGetFreeHeapSize(), (unsigned int) xPortGetMinimumEverFreeHeapSize());
+
+	/* Get the state of every task, including its stack high water-mark (in words). */
+	numTasks = uxTaskGetNumberOfTasks();
+	taskStatus = pvPortMalloc(numTasks * sizeof(TaskStatus_t));
+
+	if (taskStatus != NULL) {
+		numTasks = uxTaskGetSystemState(taskStatus, numTasks, NULL);
+
+		/* Stop when the write buffer is full (snprintf returns the untruncated length). */
+		for (i = 0; i < numTasks && length < (int) xWriteBufferLen; i++) {
+			length += snprintf((char *) pcWriteBuffer + length, xWriteBufferLen - length, "%s: %u\r\n",
+				taskStatus[i].pcTaskName, (unsigned int) (taskStatus[i].usStackHighWaterMark * sizeof(StackType_t)));
+		}
+		vPortFree(taskStatus);
+	}
+
+	/* Return pdFALSE, as there are no more strings to return */
+	/* Only return pdTRUE, if more strings need to be printed */
+	return pdFALSE;
+}
+
+/*
+ * Clistat Command.
+ */
+static BaseType_t prvCliStatCommand(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString ) {
+
+	unsigned long cyclesPerUs = SystemCoreClock / 1000000;
+	unsigned long avgCycles = 0;
+
+	if (cliStats.commands != 0) {
+		avgCycles = (unsigned long) (cliStats.processCycles / cliStats.commands);
+	}
+
+	/* Write the command path statistics to the write buffer. */
+	xWriteBufferLen = sprintf((char *) pcWriteBuffer,
+		"commands: %lu\r\nprocess avg: %lu us, max: %lu us\r\ncritical max: %lu us\r\noutput chars: %lu\r\n",
+		cliStats.commands, avgCycles / cyclesPerUs, cliStats.maxProcessCycles / cyclesPerUs,
+		cliStats.maxCriticalCycles / cyclesPerUs, cliStats.outputChars);
+
+	/* Return pdFALSE, as there are no more strings to return */
+	/* Only return pdTRUE, if more strings need to be printed */
+	return pdFALSE;
+}
+
+/*
+ * Hamstat Command.
+ */
+static BaseType_t prvHamStatCommand(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString ) {
+
+	/* Write the pipeline statistics to the write buffer. */
+	snprintf((char *) pcWriteBuffer, xWriteBufferLen,
+		"mode: %s\r\nin: %lu bytes, %lu bytes/s\r\nout: %lu bytes, %lu bytes/s\r\n"
+		"corrected: %lu\r\ndouble errors: %lu\r\nparity errors: %lu\r\ntx timeouts: %lu\r\nlost bytes: %lu\r\n",
+		(s4642286_hamming_pipeline_get_mode() == HAMMING_PIPELINE_ENCODE) ? "encode" : "decode",
+		hammingPipelineStats.bytesIn, hammingPipelineStats.rateIn,
+		hammingPipelineStats.bytesOut, hammingPipelineStats.rateOut,
+		hammingPipelineStats.errors.corrected, hammingPipelineStats.errors.doubleErrors,
+		hammingPipelineStats.errors.parityErrors, hammingPipelineStats.txTimeouts,
+		hammingPipelineStats.lostBytes);
+
+	/* Return pdFALSE, as there are no more strings to return */
+	/* Only return pdTRUE, if more strings need to be printed */
+	return pdFALSE;
+}
 
 /**
  * @brief This function will register all the CLI commands for CAG Mnemonic.
@@ -389,4 +496,7 @@ void s4642286_cli_init(void) {
 	FreeRTOS_CLIRegisterCommand(&xCre);
 	FreeRTOS_CLIRegisterCommand(&xSystem);
 	FreeRTOS_CLIRegisterCommand(&xUsage);
+	FreeRTOS_CLIRegisterCommand(&xHeap);
+	FreeRTOS_CLIRegisterCommand(&xCliStat);
+	FreeRTOS_CLIRegisterCommand(&xHamStat);
 }
\ No newline at end of file
@@ -38,5 +38,8 @@ static BaseType_t prvDelCommand(char *pcWriteBuffer, size_t xWriteBufferLen, con
 static BaseType_t prvCreCommand(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
 static BaseType_t prvSystemCommand(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
 static BaseType_t prvUsageCommand(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+static BaseType_t prvHeapCommand(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+static BaseType_t prvCliStatCommand(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+static BaseType_t prvHamStatCommand(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
 
 #endif
\ No newline at end of file
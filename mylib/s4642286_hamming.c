@@ -11,58 +11,105 @@
  * s4642286_lib_hamming_byte_decode() - Returns the decoded half byte from a byte.
  * s4642286_lib_hamming_parity_error() - Returns 1 if a parity error has occurred,
  * 										 or 0 for no error.
+ * s4642286_lib_hamming_secded_decode() - Returns the decoded half byte, the error
+ * 										  status and the bit position in error.
+ * s4642286_lib_hamming_buffer_encode() - Encodes a buffer of N bytes into 2N bytes.
+ * s4642286_lib_hamming_buffer_decode() - Decodes a buffer of 2N bytes into N bytes
+ * 										  and counts the errors found.
+ * s4642286_lib_hamming_selftest() - Returns the number of failed checks when
+ * 									 exhaustively verifying the codec.
  *************************************************************** 
  */
 
 #include "board.h"
 #include "processor_hal.h"
 #include "s4642286_hamming.h"
+#include <string.h>
+
+/*
+ * Hamming code is based on the following generator and parity check matrices
+ * G = [ 0 1 1 | 1 0 0 0 ;
+ *       1 0 1 | 0 1 0 0 ;
+ *       1 1 0 | 0 0 1 0 ;
+ *       1 1 1 | 0 0 0 1 ;
+ *
+ * H =
+ * [ 1 0 0 | 0 1 1 1 ;
+ *   0 1 0 | 1 0 1 1 ;
+ *   0 0 1 | 1 1 0 1 ];
+ *
+ * An encoded byte is laid out as D3 D2 D1 D0 H2 H1 H0 P0 (bit 7 to bit 0),
+ * where P0 is an even parity bit over the whole byte.
+ *
+ * The encode and decode tables below are generated by the compiler from the
+ * macros that follow, which are written directly from G and H. This keeps the
+ * tables consistent with the matrices without hand entered constants.
+ */
+
+// Extract bit n of a value.
+#define HAMMING_BIT(value, n) (((value) >> (n)) & 0x01)
+
+// Even parity of an 8 bit value (0x6996 is the parity of each 4 bit value).
+#define HAMMING_PARITY8(value) ((0x6996 >> (((value) ^ ((value) >> 4)) & 0x0F)) & 0x01)
+
+// Hamming bits of a half byte (the columns of G).
+#define HAMMING_H0(data) (HAMMING_BIT(data, 1) ^ HAMMING_BIT(data, 2) ^ HAMMING_BIT(data, 3))
+#define HAMMING_H1(data) (HAMMING_BIT(data, 0) ^ HAMMING_BIT(data, 2) ^ HAMMING_BIT(data, 3))
+#define HAMMING_H2(data) (HAMMING_BIT(data, 0) ^ HAMMING_BIT(data, 1) ^ HAMMING_BIT(data, 3))
+
+// Encoded byte of a half byte, without and with the parity bit P0.
+#define HAMMING_CODEWORD(data) ((HAMMING_H0(data) << 1) | (HAMMING_H1(data) << 2) | \
+		(HAMMING_H2(data) << 3) | (((data) & 0x0F) << 4))
+#define HAMMING_ENCODE(data) (HAMMING_CODEWORD(data) | HAMMING_PARITY8(HAMMING_CODEWORD(data)))
+
+// Syndrome of an encoded byte (the rows of H: S0 = H0^D1^D2^D3, etc).
+#define HAMMING_SYNDROME(value) (HAMMING_PARITY8((value) & 0xE2) | \
+		(HAMMING_PARITY8((value) & 0xD4) << 1) | (HAMMING_PARITY8((value) & 0xB8) << 2))
+
+// Bit position in error for each syndrome (one nibble per syndrome, 0 for no error).
+#define HAMMING_ERROR_BIT(syndrome) ((0x74536210 >> ((syndrome) * 4)) & 0x07)
+
+// Decode table entry layout.
+#define HAMMING_DECODE_VALUE_MASK 0x00FF	// Corrected byte with P0 cleared
+#define HAMMING_DECODE_BIT_SHIFT 8			// Bit position that was corrected
+#define HAMMING_DECODE_BIT_MASK 0x0700
+#define HAMMING_DECODE_SYNDROME 0x1000		// Syndrome is non zero
+#define HAMMING_DECODE_PARITY 0x2000		// Parity check failed
+#define HAMMING_DECODE_STATUS_SHIFT 12		// The two flags as a hammingStatus_t
+
+#define HAMMING_DECODE(value) ((((value) ^ (1 << HAMMING_ERROR_BIT(HAMMING_SYNDROME(value)))) & 0xFE) | \
+		(HAMMING_ERROR_BIT(HAMMING_SYNDROME(value)) << HAMMING_DECODE_BIT_SHIFT) | \
+		(HAMMING_SYNDROME(value) ? HAMMING_DECODE_SYNDROME : 0) | \
+		(HAMMING_PARITY8(value) ? HAMMING_DECODE_PARITY : 0))
+
+#define HAMMING_DECODE_ERRORS (HAMMING_DECODE_SYNDROME | HAMMING_DECODE_PARITY)
+
+// Expand a macro over a range of consecutive values.
+#define HAMMING_ROW4(f, n) f(n), f((n) + 1), f((n) + 2), f((n) + 3)
+#define HAMMING_ROW16(f, n) HAMMING_ROW4(f, n), HAMMING_ROW4(f, (n) + 4), \
+		HAMMING_ROW4(f, (n) + 8), HAMMING_ROW4(f, (n) + 12)
+#define HAMMING_ROW64(f, n) HAMMING_ROW16(f, n), HAMMING_ROW16(f, (n) + 16), \
+		HAMMING_ROW16(f, (n) + 32), HAMMING_ROW16(f, (n) + 48)
+
+// Encoded byte of each half byte.
+static const uint8_t hammingEncodeTable[16] = {
+	HAMMING_ROW16(HAMMING_ENCODE, 0)
+};
+
+// Corrected byte and error flags of each received byte.
+static const uint16_t hammingDecodeTable[256] = {
+	HAMMING_ROW64(HAMMING_DECODE, 0), HAMMING_ROW64(HAMMING_DECODE, 64),
+	HAMMING_ROW64(HAMMING_DECODE, 128), HAMMING_ROW64(HAMMING_DECODE, 192)
+};
 
 /**
   * @brief An internal function used to encode a half byte.
   * 
-  * Hamming code is based on the following generator and parity check matrices
-  * G = [ 0 1 1 | 1 0 0 0 ;
-  *       1 0 1 | 0 1 0 0 ;
-  *       1 1 0 | 0 0 1 0 ;
-  *       1 1 1 | 0 0 0 1 ;
-  *
-  * H =
-  * [ 1 0 0 | 0 1 1 1 ;
-  *   0 1 0 | 1 0 1 1 ;
-  *   0 0 1 | 1 1 0 1 ];
-  * 
   * @param value the byte to encode (first 4 bits are the data bits).
   * @return unsigned char an encoded byte.
   */
 unsigned char hamming_hbyte_encode(unsigned char value) {
-	uint8_t d0, d1, d2, d3;
-	uint8_t p0 = 0, h0, h1, h2;
-	uint8_t z;
-	unsigned char out;
-
-	/* extract bits */
-	d0 = !!(value & 0x1);
-	d1 = !!(value & 0x2);
-	d2 = !!(value & 0x4);
-	d3 = !!(value & 0x8);
-
-	/* calculate hamming parity bits */
-	h0 = d1 ^ d2 ^ d3;
-	h1 = d0 ^ d2 ^ d3;
-	h2 = d0 ^ d1 ^ d3;
-
-	/* generate out byte without parity bit P0 */
-	out = (h0 << 1) | (h1 << 2) | (h2 << 3) |
-		(d0 << 4) | (d1 << 5) | (d2 << 6) | (d3 << 7);
-
-	/* calculate even parity bit */
-	for (z = 1; z < 8; z++) {
-		p0 = p0 ^ !!(out & (1 << z));
-	}
-	out |= p0;
-
-	return out;
+	return hammingEncodeTable[value & 0x0F];
 }
 
 /**
@@ -90,51 +137,7 @@ unsigned short s4642286_lib_hamming_byte_encode(unsigned char value) {
  * @return unsigned char Return the decoded half byte from a byte.
  */
 unsigned char s4642286_lib_hamming_byte_decode(unsigned char value) {
-	uint8_t d0, d1, d2, d3, h0, h1, h2, s2, s1, s0;
-	unsigned char decodedByte = 0x00;
-
-	// Extract Hamming bits and Data bits.
-	h0 = !!(value & (1 << 1));
-	h1 = !!(value & (1 << 2));
-	h2 = !!(value & (1 << 3));
-	d0 = !!(value & (1 << 4));
-	d1 = !!(value & (1 << 5));
-	d2 = !!(value & (1 << 6));
-	d3 = !!(value & (1 << 7));
-
-	// Calculate the Syndrome.
-	s0 = h0 ^ d1 ^ d2 ^ d3;
-	s1 = h1 ^ d0 ^ d2 ^ d3;
-	s2 = h2 ^ d0 ^ d1 ^ d3;
-
-	// Correct errors if any.
-	if (!s0 && s1 && s2) {
-		// d3 bit error
-		d0 = !d0;
-	} else if (s0 && !s1 && s2) {
-		// d2 bit error
-		d1 = !d1;
-	} else if (s0 && s1 && !s2) {
-		// d1 bit error
-		d2 = !d2;
-	} else if (s0 && s1 && s2) {
-		// d0 bit error
-		d3 = !d3;
-	} else if (s0 && !s1 && !s2) {
-		// h0 bit error
-		h0 = !h0;
-	} else if (!s0 && s1 && !s2) {
-		// h1 bit error
-		h1 = !h1;
-	} else if (!s0 && !s1 && s2) {
-		// h2 bit error
-		h2 = !h2;
-	}
-
-	decodedByte  = (h0 << 1) | (h1 << 2) | (h2 << 3) |
-		(d0 << 4) | (d1 << 5) | (d2 << 6) | (d3 << 7);
-
-	return decodedByte;
+	return hammingDecodeTable[value] & HAMMING_DECODE_VALUE_MASK;
 }
 
 
@@ -147,20 +150,268 @@ unsigned char s4642286_lib_hamming_byte_decode(unsigned char value) {
  * @return int 1 if a parity error has occurred, else 0.
  */
 int s4642286_lib_hamming_parity_error(unsigned char value) {
-	uint8_t z;
-	uint8_t messageParity = 0;
-	uint8_t p0 = (value & (1 << 0)); // extracts the parity bit.
+	return (hammingDecodeTable[value] & HAMMING_DECODE_PARITY) != 0;
+}
+
+/**
+ * @brief This function decodes an encoded byte as a SECDED code using a single
+ * 		  table lookup. Single bit errors are corrected, while double bit
+ * 		  errors are reported and the data is left uncorrected.
+ * 
+ * @param value the encoded value
+ * @return hammingResult_t the decoded half byte, the corrected encoded byte,
+ * 		   the error status and the bit position in error (-1 if none).
+ */
+hammingResult_t s4642286_lib_hamming_secded_decode(unsigned char value) {
+	hammingResult_t result;
+	uint16_t entry = hammingDecodeTable[value];
+
+	result.status = (hammingStatus_t) ((entry >> HAMMING_DECODE_STATUS_SHIFT) & 0x03);
+
+	switch (result.status) {
+		case HAMMING_CORRECTED:
+		case HAMMING_PARITY_ONLY:
+			result.codeword = entry & HAMMING_DECODE_VALUE_MASK;
+			result.errorBit = (entry & HAMMING_DECODE_BIT_MASK) >> HAMMING_DECODE_BIT_SHIFT;
+			break;
+
+		case HAMMING_DOUBLE_ERROR:
+			// The syndrome points at the wrong bit, so do not correct.
+			result.codeword = value & 0xFE;
+			result.errorBit = -1;
+			break;
+
+		default:
+			result.codeword = entry & HAMMING_DECODE_VALUE_MASK;
+			result.errorBit = -1;
+			break;
+	}
+	result.data = result.codeword >> 4;
+
+	return result;
+}
+
+/**
+ * @brief Internal function to add the error flags of one decode table entry
+ * 		  to the error summary.
+ * 
+ * @param entry the decode table entry of an encoded byte.
+ * @param stats the error summary to update.
+ */
+static void hamming_count_error(uint16_t entry, hammingStats_t *stats) {
+	if ((entry & HAMMING_DECODE_ERRORS) == HAMMING_DECODE_ERRORS) {
+		stats->corrected++;
+	} else if (entry & HAMMING_DECODE_SYNDROME) {
+		stats->doubleErrors++;
+	} else if (entry & HAMMING_DECODE_PARITY) {
+		stats->parityErrors++;
+	}
+}
+
+/**
+ * @brief Internal function to get the data half byte of a decode table entry,
+ * 		  as secded_decode would. A double bit error is left uncorrected, so
+ * 		  the received data bits are returned.
+ * 
+ * @param entry the decode table entry of an encoded byte.
+ * @param value the encoded byte.
+ * @return unsigned char the data half byte in the top 4 bits.
+ */
+static unsigned char hamming_entry_data(uint16_t entry, unsigned char value) {
+	if ((entry & HAMMING_DECODE_ERRORS) == HAMMING_DECODE_SYNDROME) {
+		return value & 0xF0;
+	}
+	return entry & 0xF0;
+}
+
+/**
+ * @brief This function encodes a buffer of bytes. Each byte is encoded into two
+ * 		  bytes, in the same order as s4642286_lib_hamming_byte_encode() (low
+ * 		  half byte first). Four bytes are encoded per iteration using word
+ * 		  loads and stores (the encoded words are little endian).
+ * 
+ * @param in the bytes to encode.
+ * @param out the buffer for the encoded bytes (2 * length bytes).
+ * @param length the number of bytes to encode.
+ */
+void s4642286_lib_hamming_buffer_encode(const unsigned char *in, unsigned char *out, int length) {
+	uint32_t word, outLow, outHigh;
+	int i = 0;
+
+	for (; i + 4 <= length; i += 4) {
+		memcpy(&word, in + i, sizeof(word));
+
+		outLow = hammingEncodeTable[word & 0x0F] |
+			(hammingEncodeTable[(word >> 4) & 0x0F] << 8) |
+			(hammingEncodeTable[(word >> 8) & 0x0F] << 16) |
+			((uint32_t) hammingEncodeTable[(word >> 12) & 0x0F] << 24);
+		outHigh = hammingEncodeTable[(word >> 16) & 0x0F] |
+			(hammingEncodeTable[(word >> 20) & 0x0F] << 8) |
+			(hammingEncodeTable[(word >> 24) & 0x0F] << 16) |
+			((uint32_t) hammingEncodeTable[word >> 28] << 24);
+
+		memcpy(out + 2 * i, &outLow, sizeof(outLow));
+		memcpy(out + 2 * i + 4, &outHigh, sizeof(outHigh));
+	}
+
+	// Encode any remaining bytes one at a time.
+	for (; i < length; i++) {
+		out[2 * i] = hammingEncodeTable[in[i] & 0x0F];
+		out[2 * i + 1] = hammingEncodeTable[in[i] >> 4];
+	}
+}
+
+/**
+ * @brief This function decodes a buffer of encoded bytes, correcting single bit
+ * 		  errors. Four data bytes are decoded per iteration using word loads and
+ * 		  stores, and blocks without errors skip the error accounting.
+ * 		  -> As in s4642286_lib_hamming_secded_decode(), a half byte with a
+ * 		  double bit error is left as received (the syndrome points at the
+ * 		  wrong bit). s4642286_lib_hamming_byte_decode() still flips that bit.
+ * 
+ * @param in the encoded bytes (2 * length bytes).
+ * @param out the buffer for the decoded bytes.
+ * @param length the number of bytes to decode.
+ * @param errors if not NULL, receives the number of encoded bytes in error
+ * 				 (0 to 2) for each decoded byte.
+ * @param stats if not NULL, the error summary is added to this struct.
+ * @return int the number of encoded bytes that contained an error.
+ */
+int s4642286_lib_hamming_buffer_decode(const unsigned char *in, unsigned char *out, int length,
+		unsigned char *errors, hammingStats_t *stats) {
+	uint32_t inLow, inHigh, word;
+	uint16_t entry[8];
+	int numErrors = 0;
+	int i = 0, j;
+
+	for (; i + 4 <= length; i += 4) {
+		memcpy(&inLow, in + 2 * i, sizeof(inLow));
+		memcpy(&inHigh, in + 2 * i + 4, sizeof(inHigh));
+
+		for (j = 0; j < 4; j++) {
+			entry[j] = hammingDecodeTable[(inLow >> (8 * j)) & 0xFF];
+			entry[j + 4] = hammingDecodeTable[(inHigh >> (8 * j)) & 0xFF];
+		}
+
+		// Each data half byte is the top half of the corrected byte.
+		word = (entry[0] >> 4 & 0x0F) | (entry[1] & 0xF0) |
+			((entry[2] >> 4 & 0x0F) << 8) | ((entry[3] & 0xF0) << 8) |
+			((uint32_t) (entry[4] >> 4 & 0x0F) << 16) | ((uint32_t) (entry[5] & 0xF0) << 16) |
+			((uint32_t) (entry[6] >> 4 & 0x0F) << 24) | ((uint32_t) (entry[7] & 0xF0) << 24);
+		memcpy(out + i, &word, sizeof(word));
+
+		if (((entry[0] | entry[1] | entry[2] | entry[3] |
+				entry[4] | entry[5] | entry[6] | entry[7]) & HAMMING_DECODE_ERRORS) == 0) {
+			// Error free block.
+			if (errors != NULL) {
+				memset(errors + i, 0, 4);
+			}
+			continue;
+		}
+
+		for (j = 0; j < 4; j++) {
+			int count = ((entry[2 * j] & HAMMING_DECODE_ERRORS) != 0) +
+				((entry[2 * j + 1] & HAMMING_DECODE_ERRORS) != 0);
 
-	// Calculate the parity of the message.
-	for (z = 1; z < 8; z++) {
-		messageParity = messageParity ^ !!(value & (1 << z));
+			if (count != 0) {
+				out[i + j] = (hamming_entry_data(entry[2 * j], in[2 * (i + j)]) >> 4) |
+					hamming_entry_data(entry[2 * j + 1], in[2 * (i + j) + 1]);
+			}
+
+			if (errors != NULL) {
+				errors[i + j] = count;
+			}
+			if (stats != NULL) {
+				hamming_count_error(entry[2 * j], stats);
+				hamming_count_error(entry[2 * j + 1], stats);
+			}
+			numErrors += count;
+		}
+	}
+
+	// Decode any remaining bytes one at a time.
+	for (; i < length; i++) {
+		entry[0] = hammingDecodeTable[in[2 * i]];
+		entry[1] = hammingDecodeTable[in[2 * i + 1]];
+		out[i] = (hamming_entry_data(entry[0], in[2 * i]) >> 4) | hamming_entry_data(entry[1], in[2 * i + 1]);
+
+		j = ((entry[0] & HAMMING_DECODE_ERRORS) != 0) + ((entry[1] & HAMMING_DECODE_ERRORS) != 0);
+		if (errors != NULL) {
+			errors[i] = j;
+		}
+		if (stats != NULL) {
+			hamming_count_error(entry[0], stats);
+			hamming_count_error(entry[1], stats);
+		}
+		numErrors += j;
+	}
+
+	if (stats != NULL) {
+		stats->bytes += length;
+	}
+	return numErrors;
+}
+
+/**
+ * @brief This function exhaustively checks the encoder and decoder. It checks
+ * 		  the round trip of all 256 byte values, that every single bit error
+ * 		  is corrected and flagged by the parity bit, and that every double
+ * 		  bit error is detected (parity passes but the syndrome is non zero),
+ * 		  including the status reported by the SECDED decode.
+ * 
+ * @return int the number of failed checks (0 if the codec is correct).
+ */
+int s4642286_lib_hamming_selftest(void) {
+	int failures = 0;
+	int value, bit1, bit2;
+	unsigned short encoded;
+	unsigned char codeword, received;
+	hammingResult_t result;
+
+	// Round trip of every byte value.
+	for (value = 0; value < 256; value++) {
+		encoded = s4642286_lib_hamming_byte_encode(value);
+
+		if ((s4642286_lib_hamming_byte_decode(encoded & 0xFF) >> 4) != (value & 0x0F) ||
+				(s4642286_lib_hamming_byte_decode(encoded >> 8) >> 4) != (value >> 4) ||
+				s4642286_lib_hamming_parity_error(encoded & 0xFF) ||
+				s4642286_lib_hamming_parity_error(encoded >> 8)) {
+			failures++;
+		}
 	}
 
-	// Check if the parity bit matches the actual parity of the message.
-	if (p0 != messageParity) {
-		// A parity error has occurred.
-		return 1;
-	} else {
-		return 0;
+	for (value = 0; value < 16; value++) {
+		codeword = hamming_hbyte_encode(value);
+
+		for (bit1 = 0; bit1 < 8; bit1++) {
+			// Single bit errors must be corrected and cause a parity error.
+			received = codeword ^ (1 << bit1);
+
+			if (s4642286_lib_hamming_byte_decode(received) != (codeword & 0xFE) ||
+					!s4642286_lib_hamming_parity_error(received)) {
+				failures++;
+			}
+
+			// The SECDED decode must report the corrected bit and the data.
+			result = s4642286_lib_hamming_secded_decode(received);
+
+			if (result.data != value || result.errorBit != bit1 ||
+					result.status != (bit1 == 0 ? HAMMING_PARITY_ONLY : HAMMING_CORRECTED)) {
+				failures++;
+			}
+
+			// Double bit errors must pass parity but have a non zero syndrome.
+			for (bit2 = bit1 + 1; bit2 < 8; bit2++) {
+				received = codeword ^ (1 << bit1) ^ (1 << bit2);
+
+				if (s4642286_lib_hamming_parity_error(received) ||
+						s4642286_lib_hamming_byte_decode(received) == (received & 0xFE) ||
+						s4642286_lib_hamming_secded_decode(received).status != HAMMING_DOUBLE_ERROR) {
+					failures++;
+				}
+			}
+		}
 	}
-}
\ No newline at end of file
+
+	return failures;
+}
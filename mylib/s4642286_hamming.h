@@ -9,16 +9,60 @@
  ***************************************************************
  * s4642286_lib_hamming_byte_encode() - Return the 16 bit encoded value of a byte.
  * s4642286_lib_hamming_byte_decode() - Return the decoded half byte from a byte.
+ * s4642286_lib_hamming_secded_decode() - Decode a byte and classify any error.
+ * s4642286_lib_hamming_buffer_encode() - Encode a buffer of bytes.
+ * s4642286_lib_hamming_buffer_decode() - Decode a buffer of encoded bytes.
+ * s4642286_lib_hamming_selftest() - Exhaustively verify the encoder and decoder.
  *************************************************************** 
  */
 
 #ifndef S4642286_HAMMING_H
 #define S4642286_HAMMING_H
 
+/**
+ * @brief The error status of a decoded byte. The values match the syndrome
+ * 		  (bit 0) and parity (bit 1) error flags of the decode table.
+ * 
+ */
+typedef enum {
+    HAMMING_CLEAN = 0,          // No error
+    HAMMING_DOUBLE_ERROR = 1,   // Double bit error, data is not valid
+    HAMMING_PARITY_ONLY = 2,    // Parity bit error, data is valid
+    HAMMING_CORRECTED = 3       // Single bit error, data has been corrected
+} hammingStatus_t;
+
+/**
+ * @brief A struct for the result of a SECDED decode.
+ * 
+ */
+typedef struct {
+    unsigned char data;         // Decoded half byte
+    unsigned char codeword;     // Corrected encoded byte (parity bit cleared)
+    hammingStatus_t status;     // Error status
+    int errorBit;               // Bit position in error (0 is the parity bit), or -1
+} hammingResult_t;
+
+/**
+ * @brief A struct for the error summary of decoded buffers. The counts are
+ * 		  numbers of encoded bytes (each carrying half a byte of data).
+ * 
+ */
+typedef struct {
+    unsigned long bytes;            // Number of data bytes decoded
+    unsigned long corrected;        // Single bit errors that were corrected
+    unsigned long doubleErrors;     // Double bit errors (data is not valid)
+    unsigned long parityErrors;     // Errors in the parity bit only (data is valid)
+} hammingStats_t;
+
 // Function definitions
 extern unsigned short s4642286_lib_hamming_byte_encode(unsigned char value);
 extern unsigned char s4642286_lib_hamming_byte_decode(unsigned char value);
 unsigned char hamming_hbyte_encode(unsigned char value);
 extern int s4642286_lib_hamming_parity_error(unsigned char value);
+extern hammingResult_t s4642286_lib_hamming_secded_decode(unsigned char value);
+extern void s4642286_lib_hamming_buffer_encode(const unsigned char *in, unsigned char *out, int length);
+extern int s4642286_lib_hamming_buffer_decode(const unsigned char *in, unsigned char *out, int length,
+        unsigned char *errors, hammingStats_t *stats);
+extern int s4642286_lib_hamming_selftest(void);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,311 @@
+ /**
+ **************************************************************
+ * @file mylib/s4642286_hamming_ext.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Extended Hamming Code Family MyLib Source File
+ ***************************************************************
+ * EXTERNAL FUNCTIONS
+ ***************************************************************
+ * s4642286_lib_hamming_ext_encode() - Returns the codeword of a data word.
+ * s4642286_lib_hamming_ext_decode() - Returns the decoded data word, the error
+ * 									   status and the bit position in error.
+ * s4642286_lib_hamming_ext_buffer_encode() - Encodes a buffer of bytes and returns
+ * 											  the encoded size.
+ * s4642286_lib_hamming_ext_buffer_decode() - Decodes a buffer of codewords and counts
+ * 											  the errors found.
+ * s4642286_lib_hamming_ext_selftest() - Returns the number of failed checks when
+ * 										 verifying the codec.
+ ***************************************************************
+ */
+
+#include "board.h"
+#include "processor_hal.h"
+#include "s4642286_hamming.h"
+#include "s4642286_hamming_ext.h"
+#include <stddef.h>
+
+/*
+ * Syndrome bit i is the parity of the codeword positions that have bit i set
+ * in their position number. Positions above 2^m - 1 are always zero, so the
+ * same masks serve every m.
+ */
+static const uint32_t hammingExtMasks[HAMMING_EXT_M_MAX] = {
+	0xAAAAAAAA, 0xCCCCCCCC, 0xF0F0F0F0, 0xFF00FF00, 0xFFFF0000
+};
+
+// Mask of the codeword bits used for m.
+#define HAMMING_EXT_CODEWORD_MASK(m) ((m) == 5 ? 0xFFFFFFFF : ((uint32_t) 1 << HAMMING_EXT_N(m)) - 1)
+
+/**
+ * @brief Internal function to calculate the parity of a 32 bit word.
+ *
+ * @param value the word.
+ * @return uint32_t 1 if an odd number of bits are set, else 0.
+ */
+static uint32_t hamming_ext_parity(uint32_t value) {
+	value ^= value >> 16;
+	value ^= value >> 8;
+	value ^= value >> 4;
+	return (0x6996 >> (value & 0x0F)) & 0x01;
+}
+
+/**
+ * @brief Internal function to calculate the syndrome of a codeword.
+ *
+ * @param codeword the codeword.
+ * @return uint32_t the position of a single bit error (0 if none).
+ */
+static uint32_t hamming_ext_syndrome(uint32_t codeword) {
+	uint32_t syndrome = 0;
+	int i;
+
+	for (i = 0; i < HAMMING_EXT_M_MAX; i++) {
+		syndrome |= hamming_ext_parity(codeword & hammingExtMasks[i]) << i;
+	}
+	return syndrome;
+}
+
+/**
+ * @brief This function encodes a data word into an extended Hamming codeword.
+ *
+ * @param m the code size (HAMMING_EXT_M_MIN to HAMMING_EXT_M_MAX).
+ * @param data the data word (the low HAMMING_EXT_K(m) bits are used).
+ * @return uint32_t the codeword, or 0 if m is invalid.
+ */
+uint32_t s4642286_lib_hamming_ext_encode(int m, uint32_t data) {
+	uint32_t codeword, syndrome;
+	int i;
+
+	if (m < HAMMING_EXT_M_MIN || m > HAMMING_EXT_M_MAX) {
+		return 0;
+	}
+	data &= ((uint32_t) 1 << HAMMING_EXT_K(m)) - 1;
+
+	// Place the data bits between the parity bit positions (1, 2, 4, 8, 16).
+	codeword = ((data & 0x0001) << 3) | ((data & 0x000E) << 4) |
+		((data & 0x07F0) << 5) | ((data & 0x03FFF800) << 6);
+
+	// Set the parity bits so that the syndrome is zero, then the overall parity.
+	syndrome = hamming_ext_syndrome(codeword);
+	for (i = 0; i < m; i++) {
+		codeword |= ((syndrome >> i) & 0x01) << (1 << i);
+	}
+	return codeword | hamming_ext_parity(codeword);
+}
+
+/**
+ * @brief This function decodes an extended Hamming codeword. Single bit errors
+ * 		  are corrected, while double bit errors are reported and the data is
+ * 		  left uncorrected.
+ *
+ * @param m the code size (HAMMING_EXT_M_MIN to HAMMING_EXT_M_MAX).
+ * @param codeword the received codeword.
+ * @return hammingExtResult_t the decoded data word, the corrected codeword,
+ * 		   the error status and the bit position in error (-1 if none). An
+ * 		   invalid m is reported as HAMMING_DOUBLE_ERROR.
+ */
+hammingExtResult_t s4642286_lib_hamming_ext_decode(int m, uint32_t codeword) {
+	hammingExtResult_t result;
+	uint32_t syndrome, parity;
+
+	if (m < HAMMING_EXT_M_MIN || m > HAMMING_EXT_M_MAX) {
+		result.data = 0;
+		result.codeword = codeword;
+		result.status = HAMMING_DOUBLE_ERROR;
+		result.errorBit = -1;
+		return result;
+	}
+	codeword &= HAMMING_EXT_CODEWORD_MASK(m);
+
+	syndrome = hamming_ext_syndrome(codeword);
+	parity = hamming_ext_parity(codeword);
+	result.status = (hammingStatus_t) ((syndrome != 0) | (parity << 1));
+
+	switch (result.status) {
+		case HAMMING_CORRECTED:
+		case HAMMING_PARITY_ONLY:
+			// The syndrome is the position in error (0 for the parity bit).
+			codeword ^= (uint32_t) 1 << syndrome;
+			result.errorBit = syndrome;
+			break;
+
+		default:
+			// No error, or a double error that the syndrome cannot locate.
+			result.errorBit = -1;
+			break;
+	}
+	result.codeword = codeword;
+
+	// Gather the data bits from between the parity bit positions.
+	result.data = ((codeword >> 3) & 0x0001) | ((codeword >> 4) & 0x000E) |
+		((codeword >> 5) & 0x07F0) | ((codeword >> 6) & 0x03FFF800);
+
+	return result;
+}
+
+/**
+ * @brief Internal function to add the status of one codeword to the error
+ * 		  summary.
+ *
+ * @param status the error status of a codeword.
+ * @param stats the error summary to update.
+ */
+static void hamming_ext_count_error(hammingStatus_t status, hammingStats_t *stats) {
+	if (status == HAMMING_CORRECTED) {
+		stats->corrected++;
+	} else if (status == HAMMING_DOUBLE_ERROR) {
+		stats->doubleErrors++;
+	} else if (status == HAMMING_PARITY_ONLY) {
+		stats->parityErrors++;
+	}
+}
+
+/**
+ * @brief This function encodes a buffer of bytes. The data bits are taken as a
+ * 		  continuous bit stream, HAMMING_EXT_K(m) bits per codeword, and the
+ * 		  last codeword is zero padded.
+ *
+ * @param m the code size (HAMMING_EXT_M_MIN to HAMMING_EXT_M_MAX).
+ * @param in the bytes to encode.
+ * @param out the buffer for the codewords (HAMMING_EXT_ENCODED_SIZE(m, length) bytes).
+ * @param length the number of bytes to encode.
+ * @return int the number of encoded bytes, or -1 if m is invalid.
+ */
+int s4642286_lib_hamming_ext_buffer_encode(int m, const unsigned char *in, unsigned char *out, int length) {
+	uint64_t bits = 0;
+	uint32_t codeword;
+	int numBits = 0, k = HAMMING_EXT_K(m), pos = 0;
+	int i, j;
+
+	if (m < HAMMING_EXT_M_MIN || m > HAMMING_EXT_M_MAX) {
+		return -1;
+	}
+
+	for (i = 0; i < length || numBits > 0; ) {
+		// Fill the bit accumulator until it holds a whole data word.
+		while (numBits < k && i < length) {
+			bits |= (uint64_t) in[i++] << numBits;
+			numBits += 8;
+		}
+
+		codeword = s4642286_lib_hamming_ext_encode(m, (uint32_t) bits);
+		bits >>= k;
+		numBits = (numBits > k) ? numBits - k : 0;
+
+		for (j = 0; j < HAMMING_EXT_N(m) / 8; j++) {
+			out[pos++] = codeword >> (8 * j);
+		}
+	}
+
+	return pos;
+}
+
+/**
+ * @brief This function decodes a buffer of codewords, correcting single bit
+ * 		  errors.
+ *
+ * @param m the code size (HAMMING_EXT_M_MIN to HAMMING_EXT_M_MAX).
+ * @param in the codewords (HAMMING_EXT_ENCODED_SIZE(m, length) bytes).
+ * @param out the buffer for the decoded bytes.
+ * @param length the number of bytes to decode.
+ * @param status if not NULL, receives the hammingStatus_t of each codeword
+ * 				 (HAMMING_EXT_CODEWORDS(m, length) entries).
+ * @param stats if not NULL, the error summary (counted in codewords) is added
+ * 				to this struct.
+ * @return int the number of codewords that contained an error, or -1 if m is
+ * 		   invalid.
+ */
+int s4642286_lib_hamming_ext_buffer_decode(int m, const unsigned char *in, unsigned char *out, int length,
+		unsigned char *status, hammingStats_t *stats) {
+	hammingExtResult_t result;
+	uint64_t bits = 0;
+	uint32_t codeword;
+	int numBits = 0, k = HAMMING_EXT_K(m), pos = 0, numErrors = 0;
+	int i = 0, j, n;
+
+	if (m < HAMMING_EXT_M_MIN || m > HAMMING_EXT_M_MAX) {
+		return -1;
+	}
+
+	for (n = 0; i < length; n++) {
+		codeword = 0;
+		for (j = 0; j < HAMMING_EXT_N(m) / 8; j++) {
+			codeword |= (uint32_t) in[pos++] << (8 * j);
+		}
+
+		result = s4642286_lib_hamming_ext_decode(m, codeword);
+		if (status != NULL) {
+			status[n] = result.status;
+		}
+		if (stats != NULL) {
+			hamming_ext_count_error(result.status, stats);
+		}
+		numErrors += (result.status != HAMMING_CLEAN);
+
+		// Add the data word to the bit accumulator and empty it a byte at a time.
+		bits |= (uint64_t) result.data << numBits;
+		numBits += k;
+		while (numBits >= 8 && i < length) {
+			out[i++] = bits;
+			bits >>= 8;
+			numBits -= 8;
+		}
+	}
+
+	if (stats != NULL) {
+		stats->bytes += length;
+	}
+	return numErrors;
+}
+
+/**
+ * @brief This function checks the encoder and decoder for one code size. It
+ * 		  checks the round trip of every single bit data word, and that every
+ * 		  single bit error in those codewords is corrected and every double bit
+ * 		  error is detected.
+ *
+ * @param m the code size (HAMMING_EXT_M_MIN to HAMMING_EXT_M_MAX).
+ * @return int the number of failed checks (0 if the codec is correct).
+ */
+int s4642286_lib_hamming_ext_selftest(int m) {
+	int failures = 0;
+	int bit, bit1, bit2;
+	uint32_t data, codeword;
+	hammingExtResult_t result;
+
+	if (m < HAMMING_EXT_M_MIN || m > HAMMING_EXT_M_MAX) {
+		return 1;
+	}
+
+	// Data word 0 and each single bit data word.
+	for (bit = -1; bit < HAMMING_EXT_K(m); bit++) {
+		data = (bit < 0) ? 0 : ((uint32_t) 1 << bit);
+		codeword = s4642286_lib_hamming_ext_encode(m, data);
+
+		result = s4642286_lib_hamming_ext_decode(m, codeword);
+		if (result.data != data || result.status != HAMMING_CLEAN) {
+			failures++;
+		}
+
+		for (bit1 = 0; bit1 < HAMMING_EXT_N(m); bit1++) {
+			// Single bit errors must be corrected.
+			result = s4642286_lib_hamming_ext_decode(m, codeword ^ ((uint32_t) 1 << bit1));
+			if (result.data != data || result.codeword != codeword || result.errorBit != bit1 ||
+					result.status != (bit1 == 0 ? HAMMING_PARITY_ONLY : HAMMING_CORRECTED)) {
+				failures++;
+			}
+
+			// Double bit errors must be detected.
+			for (bit2 = bit1 + 1; bit2 < HAMMING_EXT_N(m); bit2++) {
+				result = s4642286_lib_hamming_ext_decode(m,
+					codeword ^ ((uint32_t) 1 << bit1) ^ ((uint32_t) 1 << bit2));
+				if (result.status != HAMMING_DOUBLE_ERROR) {
+					failures++;
+				}
+			}
+		}
+	}
+
+	return failures;
+}
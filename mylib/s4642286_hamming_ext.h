@@ -0,0 +1,72 @@
+ /**
+ **************************************************************
+ * @file mylib/s4642286_hamming_ext.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Extended Hamming Code Family MyLib Header File
+ ***************************************************************
+ * EXTERNAL FUNCTIONS
+ ***************************************************************
+ * s4642286_lib_hamming_ext_encode() - Encode a data word into a codeword.
+ * s4642286_lib_hamming_ext_decode() - Decode a codeword and classify any error.
+ * s4642286_lib_hamming_ext_buffer_encode() - Encode a buffer of bytes.
+ * s4642286_lib_hamming_ext_buffer_decode() - Decode a buffer of encoded bytes.
+ * s4642286_lib_hamming_ext_selftest() - Verify the encoder and decoder.
+ ***************************************************************
+ */
+
+#ifndef S4642286_HAMMING_EXT_H
+#define S4642286_HAMMING_EXT_H
+
+#include <stdint.h>
+#include "s4642286_hamming.h"
+
+/*
+ * Extended Hamming(2^m, 2^m - m - 1) SECDED codes, selected by m:
+ *   m = 4 -> (16,11), 2 bytes per codeword, 45% overhead
+ *   m = 5 -> (32,26), 4 bytes per codeword, 23% overhead
+ * (m = 3 gives an (8,4) code, but with a different bit layout to
+ * s4642286_hamming.c, so the two are not interchangeable.)
+ *
+ * A codeword is held in a uint32_t. Bit p (1 to 2^m - 1) is codeword position
+ * p, with the Hamming parity bits at the power of two positions and the data
+ * bits in order at the other positions. Bit 0 is the overall parity bit.
+ *
+ * The buffer functions pack the data bits as a continuous bit stream (low bit
+ * of the first byte first), so codewords do not line up with bytes. Each
+ * codeword is sent low byte first. For the same reason the buffer decode
+ * reports a hammingStatus_t per codeword, not the per byte error count of
+ * s4642286_lib_hamming_buffer_decode().
+ */
+
+#define HAMMING_EXT_M_MIN 3
+#define HAMMING_EXT_M_MAX 5
+
+// Codeword bits (including the overall parity bit) and data bits for m.
+#define HAMMING_EXT_N(m) (1 << (m))
+#define HAMMING_EXT_K(m) ((1 << (m)) - (m) - 1)
+
+// Number of codewords and encoded bytes needed for length data bytes.
+#define HAMMING_EXT_CODEWORDS(m, length) (((length) * 8 + HAMMING_EXT_K(m) - 1) / HAMMING_EXT_K(m))
+#define HAMMING_EXT_ENCODED_SIZE(m, length) (HAMMING_EXT_CODEWORDS(m, length) * (HAMMING_EXT_N(m) / 8))
+
+/**
+ * @brief A struct for the result of an extended Hamming decode.
+ *
+ */
+typedef struct {
+    uint32_t data;              // Decoded data word (HAMMING_EXT_K(m) bits)
+    uint32_t codeword;          // Corrected codeword
+    hammingStatus_t status;     // Error status
+    int errorBit;               // Bit position in error (0 is the parity bit), or -1
+} hammingExtResult_t;
+
+// Function definitions
+extern uint32_t s4642286_lib_hamming_ext_encode(int m, uint32_t data);
+extern hammingExtResult_t s4642286_lib_hamming_ext_decode(int m, uint32_t codeword);
+extern int s4642286_lib_hamming_ext_buffer_encode(int m, const unsigned char *in, unsigned char *out, int length);
+extern int s4642286_lib_hamming_ext_buffer_decode(int m, const unsigned char *in, unsigned char *out, int length,
+        unsigned char *status, hammingStats_t *stats);
+extern int s4642286_lib_hamming_ext_selftest(int m);
+
+#endif
@@ -0,0 +1,339 @@
+ /**
+ **************************************************************
+ * @file mylib/s4642286_hamming_frame.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Interleaved Hamming Framing MyLib Source File
+ ***************************************************************
+ * EXTERNAL FUNCTIONS
+ ***************************************************************
+ * s4642286_lib_hamming_frame_encode() - Encodes a payload into a frame and
+ * 										 returns the frame size.
+ * s4642286_lib_hamming_frame_decoder_init() - Resets a frame decoder.
+ * s4642286_lib_hamming_frame_decode_byte() - Feeds one received byte to a frame
+ * 											  decoder and returns its status.
+ ***************************************************************
+ */
+
+#include "board.h"
+#include "processor_hal.h"
+#include "s4642286_hamming.h"
+#include "s4642286_hamming_frame.h"
+
+// Frame decoder states.
+#define FRAME_HUNT 0    // Waiting for SYNC0
+#define FRAME_SYNC 1    // Waiting for SYNC1
+#define FRAME_LENGTH 2  // Receiving the length field
+#define FRAME_BODY 3    // Receiving data blocks and the CRC block
+
+// CRC-32 polynomial of the STM32 CRC unit.
+#define CRC_POLY 0x04C11DB7
+
+// One bit (MSB first) of the CRC shift register, and four bits at a time.
+#define CRC_BIT(crc) (((crc) & 0x80000000) ? (((crc) << 1) ^ CRC_POLY) : ((crc) << 1))
+#define CRC_NIBBLE(n) (uint32_t) CRC_BIT(CRC_BIT(CRC_BIT(CRC_BIT((uint32_t) (n) << 28))))
+
+#ifndef S4642286_HAMMING_FRAME_HWCRC
+// CRC of each 4 bit value, generated by the compiler from the polynomial.
+static const uint32_t crcNibbleTable[16] = {
+	CRC_NIBBLE(0), CRC_NIBBLE(1), CRC_NIBBLE(2), CRC_NIBBLE(3),
+	CRC_NIBBLE(4), CRC_NIBBLE(5), CRC_NIBBLE(6), CRC_NIBBLE(7),
+	CRC_NIBBLE(8), CRC_NIBBLE(9), CRC_NIBBLE(10), CRC_NIBBLE(11),
+	CRC_NIBBLE(12), CRC_NIBBLE(13), CRC_NIBBLE(14), CRC_NIBBLE(15)
+};
+
+/**
+ * @brief Internal function to add a 32 bit word to a running CRC-32.
+ *
+ * @param crc the current CRC value.
+ * @param word the word to add.
+ * @return uint32_t the new CRC value.
+ */
+static uint32_t frame_crc_word(uint32_t crc, uint32_t word) {
+	int i;
+
+	crc ^= word;
+	for (i = 0; i < 8; i++) {
+		crc = (crc << 4) ^ crcNibbleTable[crc >> 28];
+	}
+	return crc;
+}
+#endif
+
+/**
+ * @brief Internal function to calculate the CRC-32 of a frame: the payload
+ * 		  length as one word, then the payload, zero padded to a multiple of 4
+ * 		  bytes and taken as little endian words. The length is included so
+ * 		  that a LEN field changed by errors is not hidden by the padding.
+ * 		  -> When built with S4642286_HAMMING_FRAME_HWCRC the STM32 CRC unit is
+ * 		  used instead. The CRC unit is shared, so frames must then only be
+ * 		  encoded and decoded from one task.
+ *
+ * @param data the payload.
+ * @param length the number of payload bytes.
+ * @return uint32_t the CRC value.
+ */
+static uint32_t frame_crc(const unsigned char *data, int length) {
+	uint32_t crc = 0xFFFFFFFF, word;
+	int i, j;
+
+#ifdef S4642286_HAMMING_FRAME_HWCRC
+	__CRC_CLK_ENABLE();
+	CRC->CR = CRC_CR_RESET;
+	CRC->DR = length;
+#else
+	crc = frame_crc_word(crc, length);
+#endif
+
+	for (i = 0; i < length; i += 4) {
+		word = 0;
+		for (j = 0; j < 4 && i + j < length; j++) {
+			word |= (uint32_t) data[i + j] << (8 * j);
+		}
+#ifdef S4642286_HAMMING_FRAME_HWCRC
+		CRC->DR = word;
+#else
+		crc = frame_crc_word(crc, word);
+#endif
+	}
+
+#ifdef S4642286_HAMMING_FRAME_HWCRC
+	crc = CRC->DR;
+#endif
+	return crc;
+}
+
+/**
+ * @brief Internal function to transpose an 8x8 bit matrix. The bytes are the
+ * 		  rows and the columns are numbered from the MSB, so bit b of byte j
+ * 		  moves to bit (7 - j) of byte (7 - b). For example byte 0 = 0xFF (all
+ * 		  other bytes 0) becomes 0x80 in every byte. Transposing twice gives
+ * 		  back the original matrix, so this both interleaves and de-interleaves.
+ * 		  -> Based on transpose8 from Hacker's Delight (H. S. Warren).
+ *
+ * @param in the 8 bytes to transpose.
+ * @param out the transposed 8 bytes.
+ */
+static void frame_transpose(const unsigned char *in, unsigned char *out) {
+	uint32_t x, y, t;
+
+	x = ((uint32_t) in[0] << 24) | ((uint32_t) in[1] << 16) | ((uint32_t) in[2] << 8) | in[3];
+	y = ((uint32_t) in[4] << 24) | ((uint32_t) in[5] << 16) | ((uint32_t) in[6] << 8) | in[7];
+
+	t = (x ^ (x >> 7)) & 0x00AA00AA;
+	x = x ^ t ^ (t << 7);
+	t = (y ^ (y >> 7)) & 0x00AA00AA;
+	y = y ^ t ^ (t << 7);
+
+	t = (x ^ (x >> 14)) & 0x0000CCCC;
+	x = x ^ t ^ (t << 14);
+	t = (y ^ (y >> 14)) & 0x0000CCCC;
+	y = y ^ t ^ (t << 14);
+
+	t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+	y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+	x = t;
+
+	out[0] = x >> 24;
+	out[1] = x >> 16;
+	out[2] = x >> 8;
+	out[3] = x;
+	out[4] = y >> 24;
+	out[5] = y >> 16;
+	out[6] = y >> 8;
+	out[7] = y;
+}
+
+/**
+ * @brief Internal function to encode and interleave one block of 4 bytes.
+ *
+ * @param word the 4 bytes to send (low byte first).
+ * @param out the buffer for the 8 interleaved bytes.
+ */
+static void frame_encode_block(uint32_t word, unsigned char *out) {
+	unsigned char data[4], codewords[8];
+
+	data[0] = word;
+	data[1] = word >> 8;
+	data[2] = word >> 16;
+	data[3] = word >> 24;
+
+	s4642286_lib_hamming_buffer_encode(data, codewords, 4);
+	frame_transpose(codewords, out);
+}
+
+/**
+ * @brief This function encodes a payload into a frame.
+ *
+ * @param payload the bytes to send.
+ * @param length the number of payload bytes (0 to HAMMING_FRAME_MAX_PAYLOAD).
+ * @param out the buffer for the frame.
+ * @param outSize the size of the out buffer.
+ * @return int the frame size in bytes (HAMMING_FRAME_SIZE(length)), or -1 if the
+ * 		   length is invalid or the frame does not fit in the out buffer.
+ */
+int s4642286_lib_hamming_frame_encode(const unsigned char *payload, int length,
+		unsigned char *out, int outSize) {
+	unsigned short encodedLength;
+	uint32_t word;
+	int i, j, pos;
+
+	if (length < 0 || length > HAMMING_FRAME_MAX_PAYLOAD || outSize < HAMMING_FRAME_SIZE(length)) {
+		return -1;
+	}
+
+	// Header.
+	encodedLength = s4642286_lib_hamming_byte_encode(length);
+	out[0] = HAMMING_FRAME_SYNC0;
+	out[1] = HAMMING_FRAME_SYNC1;
+	out[2] = encodedLength & 0xFF;
+	out[3] = encodedLength >> 8;
+	pos = 4;
+
+	// Data blocks (the last block is zero padded).
+	for (i = 0; i < length; i += 4) {
+		word = 0;
+		for (j = 0; j < 4 && i + j < length; j++) {
+			word |= (uint32_t) payload[i + j] << (8 * j);
+		}
+		frame_encode_block(word, out + pos);
+		pos += 8;
+	}
+
+	// CRC block.
+	frame_encode_block(frame_crc(payload, length), out + pos);
+	pos += 8;
+
+	return pos;
+}
+
+/**
+ * @brief This function resets a frame decoder so that it hunts for the start of
+ * 		  a new frame.
+ *
+ * @param decoder the frame decoder.
+ */
+void s4642286_lib_hamming_frame_decoder_init(hammingFrameDecoder_t *decoder) {
+	decoder->state = FRAME_HUNT;
+	decoder->count = 0;
+	decoder->length = 0;
+	decoder->offset = 0;
+	decoder->corrected = 0;
+}
+
+/**
+ * @brief Internal function to de-interleave and decode the current block.
+ *
+ * @param decoder the frame decoder.
+ * @param word receives the 4 decoded bytes (low byte first).
+ * @return int 1 if the block was decoded, or 0 if it has a double bit error.
+ */
+static int frame_decode_block(hammingFrameDecoder_t *decoder, uint32_t *word) {
+	unsigned char codewords[8];
+	hammingResult_t result;
+	int i;
+
+	frame_transpose(decoder->block, codewords);
+
+	*word = 0;
+	for (i = 0; i < 8; i++) {
+		result = s4642286_lib_hamming_secded_decode(codewords[i]);
+
+		if (result.status == HAMMING_DOUBLE_ERROR) {
+			return 0;
+		} else if (result.status != HAMMING_CLEAN) {
+			decoder->corrected++;
+		}
+		*word |= (uint32_t) result.data << (4 * i);
+	}
+	return 1;
+}
+
+/**
+ * @brief This function feeds one received byte to a frame decoder. It does not
+ * 		  block or allocate memory, so it can be called for every byte received
+ * 		  by a task fed from the receiver ISR.
+ *
+ * @param decoder the frame decoder.
+ * @param value the received byte.
+ * @return int HAMMING_FRAME_READY when a frame has been received (the payload is
+ * 		   in decoder->payload and its size in decoder->length), HAMMING_FRAME_BUSY
+ * 		   if more bytes are needed, or a negative HAMMING_FRAME_ERROR value if
+ * 		   the frame was dropped.
+ */
+int s4642286_lib_hamming_frame_decode_byte(hammingFrameDecoder_t *decoder, unsigned char value) {
+	hammingResult_t low, high;
+	uint32_t word;
+	int i;
+
+	switch (decoder->state) {
+		case FRAME_HUNT:
+			if (value == HAMMING_FRAME_SYNC0) {
+				decoder->state = FRAME_SYNC;
+			}
+			break;
+
+		case FRAME_SYNC:
+			if (value == HAMMING_FRAME_SYNC1) {
+				s4642286_lib_hamming_frame_decoder_init(decoder);
+				decoder->state = FRAME_LENGTH;
+			} else if (value != HAMMING_FRAME_SYNC0) {
+				decoder->state = FRAME_HUNT;
+			}
+			break;
+
+		case FRAME_LENGTH:
+			decoder->block[decoder->count++] = value;
+
+			if (decoder->count == 2) {
+				low = s4642286_lib_hamming_secded_decode(decoder->block[0]);
+				high = s4642286_lib_hamming_secded_decode(decoder->block[1]);
+				decoder->length = low.data | (high.data << 4);
+
+				if (low.status == HAMMING_DOUBLE_ERROR || high.status == HAMMING_DOUBLE_ERROR ||
+						decoder->length > HAMMING_FRAME_MAX_PAYLOAD) {
+					decoder->state = FRAME_HUNT;
+					return HAMMING_FRAME_ERROR_LENGTH;
+				}
+				decoder->corrected += (low.status != HAMMING_CLEAN) + (high.status != HAMMING_CLEAN);
+				decoder->count = 0;
+				decoder->state = FRAME_BODY;
+			}
+			break;
+
+		case FRAME_BODY:
+			decoder->block[decoder->count++] = value;
+
+			if (decoder->count < 8) {
+				break;
+			}
+			decoder->count = 0;
+
+			if (!frame_decode_block(decoder, &word)) {
+				decoder->state = FRAME_HUNT;
+				return HAMMING_FRAME_ERROR_UNCORRECTABLE;
+			}
+
+			if (decoder->offset < decoder->length) {
+				// Data block.
+				for (i = 0; i < 4 && decoder->offset < decoder->length; i++) {
+					decoder->payload[decoder->offset++] = word >> (8 * i);
+				}
+			} else {
+				// CRC block, the frame is complete.
+				decoder->state = FRAME_HUNT;
+
+				if (word != frame_crc(decoder->payload, decoder->length)) {
+					return HAMMING_FRAME_ERROR_CRC;
+				}
+				return HAMMING_FRAME_READY;
+			}
+			break;
+
+		default:
+			decoder->state = FRAME_HUNT;
+			break;
+	}
+
+	return HAMMING_FRAME_BUSY;
+}
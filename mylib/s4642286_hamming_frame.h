@@ -0,0 +1,78 @@
+ /**
+ **************************************************************
+ * @file mylib/s4642286_hamming_frame.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Interleaved Hamming Framing MyLib Header File
+ ***************************************************************
+ * EXTERNAL FUNCTIONS
+ ***************************************************************
+ * s4642286_lib_hamming_frame_encode() - Encode a payload into a frame.
+ * s4642286_lib_hamming_frame_decoder_init() - Reset a frame decoder.
+ * s4642286_lib_hamming_frame_decode_byte() - Feed one received byte to a frame decoder.
+ ***************************************************************
+ */
+
+#ifndef S4642286_HAMMING_FRAME_H
+#define S4642286_HAMMING_FRAME_H
+
+/*
+ * Frame layout (all multi byte values are sent low byte first):
+ *   SYNC0 SYNC1 | LEN (Hamming encoded, 2 bytes) | data blocks | CRC block
+ *
+ * The payload (zero padded to a multiple of 4 bytes) and then its CRC-32 are
+ * sent as blocks of 4 bytes. Each block is Hamming encoded into 8 codewords
+ * and the 8x8 bit matrix is transposed, so each byte on the link carries one
+ * bit of every codeword. A burst of up to HAMMING_FRAME_BURST_BITS bits in
+ * the blocks then hits each codeword at most once and is corrected by the
+ * decoder.
+ *
+ * Only the blocks are protected against bursts. SYNC is not encoded, and LEN
+ * is two plain Hamming codewords, so a burst over the header drops the frame
+ * (a changed LEN is caught by the CRC, which covers the length). A LEN changed
+ * to a longer frame can also take the start of the next frame with it, unless
+ * the receiver resets the decoder when the link goes idle.
+ *
+ * The CRC-32 matches the STM32 CRC unit: polynomial 0x04C11DB7, initial value
+ * 0xFFFFFFFF, no reflection and no final XOR, over little endian words (the
+ * length, then the payload). Define S4642286_HAMMING_FRAME_HWCRC to calculate
+ * it with the CRC unit.
+ */
+
+#define HAMMING_FRAME_SYNC0 0xA5
+#define HAMMING_FRAME_SYNC1 0x5A
+#define HAMMING_FRAME_MAX_PAYLOAD 64
+#define HAMMING_FRAME_BURST_BITS 8
+
+// Size of a frame carrying length payload bytes.
+#define HAMMING_FRAME_SIZE(length) (4 + 8 * ((((length) + 3) / 4) + 1))
+
+// Frame decoder return values.
+#define HAMMING_FRAME_BUSY 0                    // More bytes are needed
+#define HAMMING_FRAME_READY 1                   // A frame has been received
+#define HAMMING_FRAME_ERROR_LENGTH -1           // Length field invalid
+#define HAMMING_FRAME_ERROR_UNCORRECTABLE -2    // Double bit error in a codeword
+#define HAMMING_FRAME_ERROR_CRC -3              // CRC check failed
+
+/**
+ * @brief A struct for the state of a streaming frame decoder. The decoder
+ * 		  does not allocate memory, the caller owns this struct.
+ *
+ */
+typedef struct {
+    int state;              // Current field being received
+    int count;              // Bytes received in the current field
+    int length;             // Payload length of the current frame
+    int offset;             // Payload bytes decoded so far
+    unsigned long corrected;    // Bit errors corrected in the current frame
+    unsigned char block[8];     // Current block being received
+    unsigned char payload[HAMMING_FRAME_MAX_PAYLOAD];   // Decoded payload
+} hammingFrameDecoder_t;
+
+// Function definitions
+extern int s4642286_lib_hamming_frame_encode(const unsigned char *payload, int length,
+        unsigned char *out, int outSize);
+extern void s4642286_lib_hamming_frame_decoder_init(hammingFrameDecoder_t *decoder);
+extern int s4642286_lib_hamming_frame_decode_byte(hammingFrameDecoder_t *decoder, unsigned char value);
+
+#endif
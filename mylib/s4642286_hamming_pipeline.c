@@ -0,0 +1,304 @@
+ /**
+ **************************************************************
+ * @file mylib/s4642286_hamming_pipeline.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Hamming UART DMA pipeline mylib Task Peripheral Driver
+ ***************************************************************
+ * EXTERNAL FUNCTIONS
+ ***************************************************************
+ * s4642286_tsk_hamming_pipeline_init() - Creates the Hamming pipeline controlling task.
+ * s4642286_hamming_pipeline_set_mode() - Selects encoding or decoding.
+ * s4642286_hamming_pipeline_get_mode() - Returns the current mode.
+ ***************************************************************
+ */
+
+#include "board.h"
+#include "processor_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "s4642286_hamming.h"
+#include "s4642286_hamming_pipeline.h"
+
+// Buffer sizes (the receive buffer holds about 11ms of data at 921600 baud).
+// RX_BUFFER_SIZE must be a power of two, so the byte counts can wrap.
+#define RX_BUFFER_SIZE 1024
+#define CHUNK_SIZE 256
+
+// Longest wait for a transfer complete notification (a full output buffer takes about 6ms).
+#define TX_TIMEOUT 10
+
+// DMA2 channel 5 is connected to USART6 RX (Stream 1) and TX (Stream 6).
+#define DMA_CHANNEL_USART6 (0x05 << 25)
+
+static uint8_t rxBuffer[RX_BUFFER_SIZE];
+static uint8_t txBuffer[2][2 * CHUNK_SIZE];
+static int pipelineMode;
+
+// Half buffers filled by the receive DMA (counted by the HT and TC interrupts).
+static volatile unsigned long rxHalves;
+
+void s4642286_hamming_pipeline_hw_init(void);
+
+/**
+ * @brief Internal function to start sending a buffer with DMA2 Stream 6.
+ *
+ * @param buffer the bytes to send.
+ * @param length the number of bytes to send.
+ */
+static void pipeline_dma_send(uint8_t *buffer, int length) {
+	// Clear the Stream 6 flags, then start the transfer.
+	DMA2->HIFCR = DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6 | DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6;
+	DMA2_Stream6->M0AR = (uint32_t) buffer;
+	DMA2_Stream6->NDTR = length;
+	DMA2_Stream6->CR |= DMA_SxCR_EN;
+}
+
+/**
+ * @brief Internal function to get the total number of bytes the receive DMA
+ * 		  has written. The position in the buffer only tells where the DMA is,
+ * 		  so the half buffer count from the interrupts is needed to tell
+ * 		  whether it has lapped the task.
+ *
+ * @return unsigned long the bytes received since the pipeline started.
+ */
+static unsigned long pipeline_rx_count(void) {
+	unsigned long halves;
+	int position;
+
+	// Read the count and the position together (again if the interrupt ran in between).
+	do {
+		halves = rxHalves;
+		position = RX_BUFFER_SIZE - DMA2_Stream1->NDTR;
+	} while (halves != rxHalves);
+
+	if (position == RX_BUFFER_SIZE) {
+		position = 0;
+	}
+
+	// The DMA may have finished a half before its interrupt ran. The half it is
+	// writing now tells whether the count is odd (second half) or even.
+	if ((halves & 0x01) != (position >= RX_BUFFER_SIZE / 2)) {
+		halves++;
+	}
+
+	return (halves / 2) * RX_BUFFER_SIZE + position;
+}
+
+/**
+ * @brief The controlling task for the Hamming pipeline. It takes the bytes
+ * 		  written into the receive buffer by DMA, encodes or decodes them in
+ * 		  bulk and sends the result by DMA, alternating between two output
+ * 		  buffers so that processing overlaps sending.
+ *
+ */
+void s4642286TaskHammingPipeline(void) {
+	unsigned long rxRead = 0, pending, lost;
+	int length;
+	int txIndex = 0;
+	uint8_t chunk[CHUNK_SIZE];
+	uint8_t carry = 0;
+	int haveCarry = 0;
+	unsigned long lastBytesIn = 0, lastBytesOut = 0;
+	TickType_t lastRateTick = xTaskGetTickCount();
+
+	s4642286_hamming_pipeline_hw_init();
+
+	for (;;) {
+		while ((pending = pipeline_rx_count() - rxRead) > 0) {
+
+			// If the DMA has overwritten unread bytes, drop everything but the newest
+			// half buffer (the oldest bytes are about to be overwritten too). The
+			// carry is dropped as well, keeping the encoded byte pairs aligned.
+			if (pending > RX_BUFFER_SIZE) {
+				lost = pending - (RX_BUFFER_SIZE / 2);
+				if ((lost + haveCarry) & 0x01) {
+					lost++;
+				}
+				rxRead += lost;
+				pending -= lost;
+				hammingPipelineStats.lostBytes += lost + haveCarry;
+				haveCarry = 0;
+			}
+
+			// Copy out a chunk, keeping any odd byte when decoding for the next pass.
+			length = 0;
+			if (haveCarry) {
+				chunk[length++] = carry;
+				haveCarry = 0;
+			}
+			while (length < CHUNK_SIZE && pending > 0) {
+				chunk[length++] = rxBuffer[rxRead % RX_BUFFER_SIZE];
+				rxRead++;
+				pending--;
+				hammingPipelineStats.bytesIn++;
+			}
+
+			if (pipelineMode == HAMMING_PIPELINE_DECODE && (length & 0x01)) {
+				carry = chunk[--length];
+				haveCarry = 1;
+			}
+			if (length == 0) {
+				break;
+			}
+
+			// Process into the free buffer while the other one is being sent.
+			if (pipelineMode == HAMMING_PIPELINE_ENCODE) {
+				s4642286_lib_hamming_buffer_encode(chunk, txBuffer[txIndex], length);
+				length *= 2;
+			} else {
+				length /= 2;
+				s4642286_lib_hamming_buffer_decode(chunk, txBuffer[txIndex], length, NULL,
+					&hammingPipelineStats.errors);
+			}
+
+			// Wait for the previous transfer to finish. The stream clears EN when it
+			// is done, so a late or stale notification cannot re-arm it early.
+			while (DMA2_Stream6->CR & DMA_SxCR_EN) {
+				if (ulTaskNotifyTake(pdTRUE, TX_TIMEOUT) == 0) {
+					hammingPipelineStats.txTimeouts++;
+				}
+			}
+
+			pipeline_dma_send(txBuffer[txIndex], length);
+			hammingPipelineStats.bytesOut += length;
+			txIndex ^= 1;
+		}
+
+		// Update the throughput every second.
+		if ((xTaskGetTickCount() - lastRateTick) >= 1000) {
+			hammingPipelineStats.rateIn = hammingPipelineStats.bytesIn - lastBytesIn;
+			hammingPipelineStats.rateOut = hammingPipelineStats.bytesOut - lastBytesOut;
+			lastBytesIn = hammingPipelineStats.bytesIn;
+			lastBytesOut = hammingPipelineStats.bytesOut;
+			lastRateTick = xTaskGetTickCount();
+		}
+
+		// Delay the task for 2ms.
+		vTaskDelay(2);
+	}
+}
+
+/**
+ * @brief Creates the Hamming pipeline controlling task.
+ *
+ * @param mode HAMMING_PIPELINE_ENCODE or HAMMING_PIPELINE_DECODE.
+ */
+void s4642286_tsk_hamming_pipeline_init(int mode) {
+	pipelineMode = mode;
+	xTaskCreate( (void *) &s4642286TaskHammingPipeline, (const signed char *) "HAMMING", HAMMINGPIPELINETASK_STACK_SIZE, NULL, HAMMINGPIPELINETASK_PRIORITY, &xHammingPipelineHandle);
+}
+
+/**
+ * @brief Selects whether received bytes are encoded or decoded.
+ *
+ * @param mode HAMMING_PIPELINE_ENCODE or HAMMING_PIPELINE_DECODE.
+ */
+void s4642286_hamming_pipeline_set_mode(int mode) {
+	pipelineMode = mode;
+}
+
+/**
+ * @brief Returns whether received bytes are encoded or decoded.
+ *
+ * @return int HAMMING_PIPELINE_ENCODE or HAMMING_PIPELINE_DECODE.
+ */
+int s4642286_hamming_pipeline_get_mode(void) {
+	return pipelineMode;
+}
+
+/**
+ * @brief Initialises USART6 on PG14 (TX) and PG9 (RX), and the DMA streams
+ * 		  used to receive into the circular buffer and to send results.
+ *
+ */
+void s4642286_hamming_pipeline_hw_init(void) {
+	// Enable the GPIO G, USART6 and DMA2 clocks.
+	__GPIOG_CLK_ENABLE();
+	__USART6_CLK_ENABLE();
+	__DMA2_CLK_ENABLE();
+
+	// Set PG9 and PG14 to Alternate Function 8 (USART6).
+	GPIOG->OSPEEDR |= ((GPIO_SPEED_FAST << (9 * 2)) | (GPIO_SPEED_FAST << (14 * 2)));	// Set fast speed.
+	GPIOG->PUPDR &= ~((0x03 << (9 * 2)) | (0x03 << (14 * 2)));							// Clear bits for no push/pull
+	GPIOG->PUPDR |= (0x01 << (9 * 2));													// Pull up on RX
+	GPIOG->MODER &= ~((0x03 << (9 * 2)) | (0x03 << (14 * 2)));							// Clear bits
+	GPIOG->MODER |= ((GPIO_MODE_AF_PP << (9 * 2)) | (GPIO_MODE_AF_PP << (14 * 2)));		// Set Alternate Function Push Pull Mode
+
+	GPIOG->AFR[1] &= ~((0x0F << (1 * 4)) | (0x0F << (6 * 4)));							// Clear Alternate Function bits for pins (Higher ARF register)
+	GPIOG->AFR[1] |= ((GPIO_AF8_USART6 << (1 * 4)) | (GPIO_AF8_USART6 << (6 * 4)));	// Set Alternate Function 8 for pins
+
+	// Set 8N1 at the pipeline baud rate (USART6 is on APB2), with DMA for both directions.
+	USART6->CR1 = 0;
+	USART6->BRR = (HAL_RCC_GetPCLK2Freq() + (HAMMING_PIPELINE_BAUD / 2)) / HAMMING_PIPELINE_BAUD;
+	USART6->CR2 = 0;
+	USART6->CR3 = USART_CR3_DMAR | USART_CR3_DMAT;
+
+	// Receive stream: peripheral to memory, circular, byte transfers, interrupt
+	// on each half buffer so that overruns can be detected.
+	DMA2_Stream1->CR &= ~DMA_SxCR_EN;
+	while (DMA2_Stream1->CR & DMA_SxCR_EN);
+	DMA2->LIFCR = DMA_LIFCR_CTCIF1 | DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTEIF1 | DMA_LIFCR_CDMEIF1 | DMA_LIFCR_CFEIF1;
+	rxHalves = 0;
+	DMA2_Stream1->PAR = (uint32_t) &USART6->DR;
+	DMA2_Stream1->M0AR = (uint32_t) rxBuffer;
+	DMA2_Stream1->NDTR = RX_BUFFER_SIZE;
+	DMA2_Stream1->CR = DMA_CHANNEL_USART6 | DMA_SxCR_PL_1 | DMA_SxCR_MINC | DMA_SxCR_CIRC |
+		DMA_SxCR_HTIE | DMA_SxCR_TCIE;
+	DMA2_Stream1->CR |= DMA_SxCR_EN;
+
+	// Transmit stream: memory to peripheral, byte transfers, interrupt on completion.
+	DMA2_Stream6->CR &= ~DMA_SxCR_EN;
+	while (DMA2_Stream6->CR & DMA_SxCR_EN);
+	DMA2_Stream6->PAR = (uint32_t) &USART6->DR;
+	DMA2_Stream6->CR = DMA_CHANNEL_USART6 | DMA_SxCR_PL_0 | DMA_SxCR_MINC | DMA_SxCR_DIR_0 | DMA_SxCR_TCIE;
+
+	// Enable priority (10) and interrupt callbacks. Do not set a priority lower than 5.
+	HAL_NVIC_SetPriority(DMA2_Stream1_IRQn, 10, 0);
+	HAL_NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+	HAL_NVIC_SetPriority(DMA2_Stream6_IRQn, 10, 0);
+	HAL_NVIC_EnableIRQ(DMA2_Stream6_IRQn);
+
+	USART6->CR1 = USART_CR1_UE | USART_CR1_TE | USART_CR1_RE;
+}
+
+/**
+ * @brief Interrupt handler (ISR) for DMA2 Stream 1 (USART6 RX). Counts the
+ * 		  half buffers written, for the overrun check in the pipeline task.
+ *
+ */
+void DMA2_Stream1_IRQHandler(void) {
+
+	if ((DMA2->LISR & DMA_LISR_HTIF1) == DMA_LISR_HTIF1) {
+		// Clear the half transfer flag.
+		DMA2->LIFCR = DMA_LIFCR_CHTIF1;
+		rxHalves++;
+	}
+
+	if ((DMA2->LISR & DMA_LISR_TCIF1) == DMA_LISR_TCIF1) {
+		// Clear the transfer complete flag.
+		DMA2->LIFCR = DMA_LIFCR_CTCIF1;
+		rxHalves++;
+	}
+}
+
+/**
+ * @brief Interrupt handler (ISR) for DMA2 Stream 6 (USART6 TX). Notifies the
+ * 		  pipeline task that the output buffer is free again.
+ *
+ */
+void DMA2_Stream6_IRQHandler(void) {
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if ((DMA2->HISR & DMA_HISR_TCIF6) == DMA_HISR_TCIF6) {
+		// Clear the transfer complete flag.
+		DMA2->HIFCR = DMA_HIFCR_CTCIF6;
+
+		if (xHammingPipelineHandle != NULL) {
+			vTaskNotifyGiveFromISR(xHammingPipelineHandle, &xHigherPriorityTaskWoken);
+		}
+	}
+
+	// Perform context switching, if required.
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
@@ -0,0 +1,69 @@
+ /**
+ **************************************************************
+ * @file mylib/s4642286_hamming_pipeline.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Hamming UART DMA pipeline mylib Task Peripheral Driver
+ ***************************************************************
+ * EXTERNAL FUNCTIONS
+ ***************************************************************
+ * s4642286_tsk_hamming_pipeline_init() - Creates the Hamming pipeline controlling task.
+ * s4642286_hamming_pipeline_set_mode() - Selects encoding or decoding.
+ * s4642286_hamming_pipeline_get_mode() - Returns the current mode.
+ ***************************************************************
+ */
+
+#ifndef S4642286_HAMMING_PIPELINE_H
+#define S4642286_HAMMING_PIPELINE_H
+
+#include "s4642286_hamming.h"
+
+/*
+ * The pipeline runs on USART6 (PG14 TX, PG9 RX, Arduino D1/D0) at
+ * HAMMING_PIPELINE_BAUD, so the debug console stays on USART3. Received bytes
+ * are written by DMA2 Stream 1 into a circular buffer, encoded or decoded in
+ * bulk by the task, and sent by DMA2 Stream 6 from one of two output buffers.
+ *
+ * When encoding, each received byte produces two bytes, so the pipeline can
+ * only keep up with half the line rate on input. When decoding, it keeps up
+ * with the full line rate.
+ */
+
+// External Function Definitions
+extern void s4642286_tsk_hamming_pipeline_init(int mode);
+extern void s4642286_hamming_pipeline_set_mode(int mode);
+extern int s4642286_hamming_pipeline_get_mode(void);
+
+// Task Priority
+#define HAMMINGPIPELINETASK_PRIORITY	( tskIDLE_PRIORITY + 4 )
+
+// Task Stack Size
+#define HAMMINGPIPELINETASK_STACK_SIZE ( configMINIMAL_STACK_SIZE * 3 )
+
+// Pipeline modes
+#define HAMMING_PIPELINE_ENCODE 0
+#define HAMMING_PIPELINE_DECODE 1
+
+#define HAMMING_PIPELINE_BAUD 921600
+
+/**
+ * @brief A struct for the pipeline throughput and error statistics.
+ *
+ */
+typedef struct {
+    unsigned long bytesIn;      // Total bytes received
+    unsigned long bytesOut;     // Total bytes sent
+    unsigned long rateIn;       // Bytes received in the last second
+    unsigned long rateOut;      // Bytes sent in the last second
+    unsigned long txTimeouts;   // Waits for a transfer complete notification that timed out
+    unsigned long lostBytes;    // Received bytes dropped because the DMA overran the task
+    hammingStats_t errors;      // Decoding error summary
+} hammingPipelineStats_t;
+
+// Pipeline statistics, updated by the pipeline task.
+hammingPipelineStats_t hammingPipelineStats;
+
+// Task handle for the pipeline.
+TaskHandle_t xHammingPipelineHandle;
+
+#endif
@@ -10,15 +10,91 @@
  * s4642286_irremote_init() - Initialises the IR Receiver hardware.
  * s4642286_irremote_recv() - Processes the recieved input waveform.
  * s4642286_irremote_readkey() - Reads the key that has been detected.
+ * s4642286_irremote_frame_get() - Removes the oldest received frame from the queue.
+ * s4642286_irremote_notify_task() - Sets the task notified for each received frame.
+ * s4642286_irremote_keymap_load() - Loads a keymap used to translate frames to keys.
+ * s4642286_irremote_keymap_lookup() - Translates a frame code to a key.
+ * s4642286_irremote_capture_process() - Decodes the edges captured by DMA.
+ * s4642286_tsk_irremote_init() - Creates the IR remote controlling task (DMA capture only).
  *************************************************************** 
  */
 
 #include "board.h"
 #include "processor_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
 #include "s4642286_irremote.h"
+#include "s4642286_irremote_nec.h"
 
-uint32_t timerValue, currentTimerValue = 0, lastTimerValue = 0, bitPattern = 0;
-int pulseCount = 0;
+// NEC decoder, only used by the TIM2 ISR (or the capture task).
+static necDecoder_t necDecoder;
+
+// Default keymap (sorted by code).
+static const irKey_t defaultKeymap[] = {
+	{ FOUR, '4' }, { TWO, '2' }, { ONE, '1' }, { FIVE, '5' }, { SEVEN, '7' },
+	{ EIGHT, '8' }, { NINE, '9' }, { SIX, '6' }, { ZERO, '0' }, { THREE, '3' }
+};
+
+// Keymap in use.
+static const irKey_t *keymap = defaultKeymap;
+static int keymapSize = sizeof(defaultKeymap) / sizeof(defaultKeymap[0]);
+
+/* Received frames, written only by the TIM2 ISR (frameHead) and read only by
+ * the receiving task (frameTail), so no locking is needed. The indices are
+ * free running and wrap with the queue size mask. */
+static irFrame_t frameQueue[IR_FRAME_QUEUE_SIZE];
+static volatile uint32_t frameHead = 0, frameTail = 0;
+
+// Task to notify when a frame is received.
+static TaskHandle_t notifyTask = NULL;
+
+#ifdef S4642286_IRREMOTE_DMA
+// DMA1 Stream 1 channel 3 is connected to TIM2 CH3.
+#define DMA_CHANNEL_TIM2_CH3 (0x03 << 25)
+
+// Capture times written by DMA, and the next one to decode.
+static uint32_t captureBuffer[IR_CAPTURE_BUFFER_SIZE];
+static int captureIndex = 0;
+
+void s4642286_irremote_dma_init(void);
+#endif
+
+/**
+ * @brief Internal function to add a received frame to the queue and notify
+ *		  the receiving task. Called by the timer input capture ISR (or by
+ *		  s4642286_irremote_capture_process()). The frame is dropped if the
+ *		  queue is full.
+ * 
+ * @param code the 32 bit frame.
+ * @param repeat 1 if the frame was a repeat code, else 0.
+ */
+static void irremote_frame_put(uint32_t code, uint8_t repeat) {
+	uint32_t head = frameHead;
+
+	if ((head - frameTail) >= IR_FRAME_QUEUE_SIZE) {
+		return;
+	}
+
+	frameQueue[head & (IR_FRAME_QUEUE_SIZE - 1)].code = code;
+	frameQueue[head & (IR_FRAME_QUEUE_SIZE - 1)].timestamp = HAL_GetTick();
+	frameQueue[head & (IR_FRAME_QUEUE_SIZE - 1)].repeat = repeat;
+
+	// Make sure the frame is written before it is published.
+	__DMB();
+	frameHead = head + 1;
+
+	if (notifyTask != NULL) {
+#ifdef S4642286_IRREMOTE_DMA
+		// Frames are decoded in task context.
+		xTaskNotifyGive(notifyTask);
+#else
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		vTaskNotifyGiveFromISR(notifyTask, &xHigherPriorityTaskWoken);
+		portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+#endif
+	}
+}
 
 
 /**
@@ -42,9 +118,14 @@ void s4642286_irremote_init() {
     __TIM2_CLK_ENABLE();
 
 	/* Compute the prescaler value
-	Set the clock prescaler to 50kHz
+	Set the clock prescaler to 1MHz, so captures are in us
 	SystemCoreClock is the system clock frequency */
 	TIM2->PSC = ((SystemCoreClock / 2) / TIMER_COUNTER_FREQ) - 1;
+	TIM2->ARR = 0xFFFFFFFF;
+
+	// Generate an update event to load the prescaler.
+	TIM2->EGR = TIM_EGR_UG;
+	TIM2->SR &= ~TIM_SR_UIF;
 
 	// Set timer to count up.
 	TIM2->CR1 &= ~TIM_CR1_DIR;
@@ -66,57 +147,66 @@ void s4642286_irremote_init() {
 	// Enable capture for Channel 3.
 	TIM2->CCER |= TIM_CCER_CC3E;
 
+#ifdef S4642286_IRREMOTE_DMA
+	// Request a DMA transfer (instead of an interrupt) for each capture on Channel 3.
+	s4642286_irremote_dma_init();
+	TIM2->DIER |= TIM_DIER_CC3DE;
+#else
 	// Enable interrupts and enable Capture interrupts for Channel 3.
 	TIM2->DIER |= TIM_DIER_CC3IE; 
 
-	// Enable update interrupt to occur on timer counter overflow or underflow.
-	TIM2->DIER |= TIM_DIER_UIE;
-
 	// Enable priority (10) and interrupt callback. Do not set a priority lower than 5.
 	HAL_NVIC_SetPriority(TIM2_IRQn, 10, 0);
 	HAL_NVIC_EnableIRQ(TIM2_IRQn);
+#endif
+
+	// Reset the NEC decoder.
+	s4642286_irremote_nec_init(&necDecoder);
 
 	// Enable Timer to start counting.
 	TIM2->CR1 |= TIM_CR1_CEN;
 }
 
+/**
+ * @brief Internal function to feed one falling edge to the NEC decoder, and
+ *		  queue any frame or repeat code it completes.
+ * 
+ * @param edge the capture time of the falling edge (us).
+ */
+static void irremote_edge(uint32_t edge) {
+	uint32_t code;
+
+	switch (s4642286_irremote_nec_edge(&necDecoder, edge, &code)) {
+		case NEC_FRAME:
+			irremote_frame_put(code, 0);
+			break;
+
+		case NEC_REPEAT:
+			irremote_frame_put(code, 1);
+			break;
+
+		default:
+			break;
+	}
+}
+
 /**
  * @brief Processes the recieved input waveform. This function is 
  *		  called by the timer input capture ISR.
  * 
  */
 void s4642286_irremote_recv() {
-	// Check for overflow
-	if ((TIM2->SR & TIM_SR_UIF) != TIM_SR_UIF) {	 
-		TIM2->SR &= ~TIM_SR_UIF; 	// Clear the UIF Flag
+	uint32_t edge;
+
+	// Clear the update flag (the 32 bit counter wraps without affecting intervals).
+	if ((TIM2->SR & TIM_SR_UIF) == TIM_SR_UIF) {
+		TIM2->SR &= ~TIM_SR_UIF;
 	}
 
-	// Check if input capture has taken place 
+	// Check if input capture has taken place (reading CCR3 clears the flag).
 	if ((TIM2->SR & TIM_SR_CC3IF) == TIM_SR_CC3IF) { 
-		currentTimerValue = TIM2->CCR3;
-
-		pulseCount++;
-
-		timerValue = (currentTimerValue - lastTimerValue) / 2000;
-		// If the pulse width is greater than 500ms, this will mark the SOF
-		if (timerValue >= 500) {
-			// First 2 counts needs to be skipped hence pulse count is set to -2 
-			pulseCount = -2;
-			bitPattern = 0;
-		} else if ((pulseCount >= 0) && (pulseCount < 32)) {  
-			// Accumulate the bit values between 0-31.
-			// pulse width greater than 12ms is considered as LOGIC1
-			if (timerValue >= 12) {
-				bitPattern |= (uint32_t)1 << (31 - pulseCount);
-			}
-		}
-		
-		if (pulseCount >= 32) {
-			// This will mark the End of frame as 32 pulses are received
-			pulseCount = 0;
-			keyPressedFlag = 1;
-		}
-		lastTimerValue = currentTimerValue;
+		edge = TIM2->CCR3;
+		irremote_edge(edge);
 	}
 }
 
@@ -128,51 +218,178 @@ void TIM2_IRQHandler(void) {
 	s4642286_irremote_recv();
 }
 
+#ifdef S4642286_IRREMOTE_DMA
+/**
+ * @brief Initialises DMA1 Stream 1 to copy each TIM2 Channel 3 capture into
+ *		  the circular capture buffer.
+ * 
+ */
+void s4642286_irremote_dma_init(void) {
+	// Enable the DMA1 clock.
+	__DMA1_CLK_ENABLE();
+
+	// Peripheral to memory, circular, word transfers, no interrupts.
+	DMA1_Stream1->CR &= ~DMA_SxCR_EN;
+	while (DMA1_Stream1->CR & DMA_SxCR_EN);
+	DMA1->LIFCR = DMA_LIFCR_CTCIF1 | DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTEIF1 | DMA_LIFCR_CDMEIF1 | DMA_LIFCR_CFEIF1;
+	DMA1_Stream1->PAR = (uint32_t) &TIM2->CCR3;
+	DMA1_Stream1->M0AR = (uint32_t) captureBuffer;
+	DMA1_Stream1->NDTR = IR_CAPTURE_BUFFER_SIZE;
+	DMA1_Stream1->CR = DMA_CHANNEL_TIM2_CH3 | DMA_SxCR_PL_0 | DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1 |
+		DMA_SxCR_MINC | DMA_SxCR_CIRC;
+	DMA1_Stream1->CR |= DMA_SxCR_EN;
+
+	captureIndex = 0;
+}
+
+/**
+ * @brief Decodes the edges captured by DMA since the last call. The decoder
+ *		  keeps its state between calls, so this can be called at any time,
+ *		  as long as it is called before the capture buffer wraps (at least
+ *		  every IR_CAPTURE_POLL ms).
+ * 
+ */
+void s4642286_irremote_capture_process(void) {
+	int writeIndex;
+
+	// Position of the next capture the DMA will write.
+	writeIndex = IR_CAPTURE_BUFFER_SIZE - DMA1_Stream1->NDTR;
+	if (writeIndex == IR_CAPTURE_BUFFER_SIZE) {
+		writeIndex = 0;
+	}
+
+	while (captureIndex != writeIndex) {
+		irremote_edge(captureBuffer[captureIndex]);
+		captureIndex = (captureIndex + 1) % IR_CAPTURE_BUFFER_SIZE;
+	}
+}
+
 /**
- * @brief Checks if a certain key has been detected.
+ * @brief The controlling task for the IR remote. It initialises the receiver
+ *		  and decodes the captured edges every IR_CAPTURE_POLL ms.
+ * 
+ */
+void s4642286TaskIrremote(void) {
+	s4642286_irremote_init();
+
+	for (;;) {
+		s4642286_irremote_capture_process();
+
+		// Delay the task for IR_CAPTURE_POLL ms.
+		vTaskDelay(IR_CAPTURE_POLL);
+	}
+}
+
+/**
+ * @brief Creates the IR remote controlling task.
+ * 
+ */
+void s4642286_tsk_irremote_init(void) {
+	xTaskCreate( (void *) &s4642286TaskIrremote, (const signed char *) "IRREMOTE", IRREMOTETASK_STACK_SIZE, NULL, IRREMOTETASK_PRIORITY, NULL);
+}
+#endif
+
+/**
+ * @brief Removes the oldest received frame from the queue. Must only be called
+ *		  from one task.
+ * 
+ * @param frame a pointer to store the frame in.
+ * @return int 1 if a frame was removed, or 0 if the queue is empty.
+ */
+int s4642286_irremote_frame_get(irFrame_t *frame) {
+	uint32_t tail = frameTail;
+
+	if (tail == frameHead) {
+		return 0;
+	}
+
+	*frame = frameQueue[tail & (IR_FRAME_QUEUE_SIZE - 1)];
+
+	// Make sure the frame is read before its slot is released.
+	__DMB();
+	frameTail = tail + 1;
+	return 1;
+}
+
+/**
+ * @brief Sets the task that is notified (vTaskNotifyGiveFromISR) each time a
+ *		  frame is received, so it can block on ulTaskNotifyTake() and then
+ *		  drain the queue.
+ * 
+ * @param task the task handle, or NULL to stop notifying.
+ */
+void s4642286_irremote_notify_task(TaskHandle_t task) {
+	notifyTask = task;
+}
+
+/**
+ * @brief Loads a keymap used to translate received frames to keys. The keymap
+ *		  is not copied, so it must stay valid while in use.
+ * 
+ * @param map the keymap, sorted by code in ascending order (no duplicates).
+ *			  NULL loads the default keymap (the digit keys).
+ * @param size the number of entries in the keymap.
+ * @return int 0 if the keymap was loaded, or -1 if it is not sorted.
+ */
+int s4642286_irremote_keymap_load(const irKey_t *map, int size) {
+	int i;
+
+	if (map == NULL) {
+		map = defaultKeymap;
+		size = sizeof(defaultKeymap) / sizeof(defaultKeymap[0]);
+	}
+
+	for (i = 1; i < size; i++) {
+		if (map[i].code <= map[i - 1].code) {
+			return -1;
+		}
+	}
+
+	keymap = map;
+	keymapSize = size;
+	return 0;
+}
+
+/**
+ * @brief Translates a frame code to a key using a binary search of the keymap.
+ * 
+ * @param code the 32 bit frame.
+ * @param value a pointer to store the key in.
+ * @return int 1 if the code is in the keymap, else 0.
+ */
+int s4642286_irremote_keymap_lookup(uint32_t code, char *value) {
+	int low = 0, high = keymapSize - 1, mid;
+
+	while (low <= high) {
+		mid = (low + high) / 2;
+
+		if (keymap[mid].code == code) {
+			*value = keymap[mid].key;
+			return 1;
+		} else if (keymap[mid].code < code) {
+			low = mid + 1;
+		} else {
+			high = mid - 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * @brief Checks if a certain key has been detected. Repeat codes and codes
+ *		  that are not in the keymap are skipped, so a held key is only read
+ *		  once.
  * 
  * @param value a pointer to the buffer to store the character in.
  * @return int Returns 1 if a key has been detected, else 0.
  */
 int s4642286_irremote_readkey(char *value) {
-	if (keyPressedFlag) {
-		switch (0xFFFFFF & bitPattern) {
-			case ZERO:
-				*value = '0';
-				break;
-			case ONE:
-				*value = '1';
-				break;
-			case TWO:
-				*value = '2';
-				break;
-			case THREE:
-				*value = '3';
-				break;
-			case FOUR:
-				*value = '4';
-				break;
-			case FIVE:
-				*value = '5';
-				break;
-			case SIX:
-				*value = '6';
-				break;
-			case SEVEN:
-				*value = '7';
-				break;
-			case EIGHT:
-				*value = '8';
-				break;
-			case NINE:
-				*value = '9';
-				break;
-			default:
-				break;
+	irFrame_t frame;
+
+	while (s4642286_irremote_frame_get(&frame)) {
+		if (!frame.repeat && s4642286_irremote_keymap_lookup(frame.code, value)) {
+			return 1;
 		}
-		// Clear keyPressedFlag
-		keyPressedFlag = 0;
-		return 1;
 	}
 	return 0;
 }
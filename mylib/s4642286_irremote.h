@@ -10,21 +10,85 @@
  * s4642286_irremote_init() - Initialises the IR Receiver hardware.
  * s4642286_irremote_recv() - Processes the recieved input waveform.
  * s4642286_irremote_readkey() - Reads the key that has been detected.
+ * s4642286_irremote_frame_get() - Removes the oldest received frame from the queue.
+ * s4642286_irremote_notify_task() - Sets the task notified for each received frame.
+ * s4642286_irremote_keymap_load() - Loads a keymap used to translate frames to keys.
+ * s4642286_irremote_keymap_lookup() - Translates a frame code to a key.
+ * s4642286_irremote_capture_process() - Decodes the edges captured by DMA.
+ * s4642286_tsk_irremote_init() - Creates the IR remote controlling task (DMA capture only).
  *************************************************************** 
  */
 
 #ifndef S4642286_IRREMOTE_H
 #define S4642286_IRREMOTE_H
 
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief A struct for a frame received from the IR remote.
+ * 
+ */
+typedef struct {
+    uint32_t code;          // 32 bit frame (the last frame's code for a repeat)
+    uint32_t timestamp;     // HAL_GetTick() when the frame ended
+    uint8_t repeat;         // 1 if this was a repeat code (key held down)
+} irFrame_t;
+
+/**
+ * @brief A struct for one keymap entry, translating a frame code to a key.
+ * 
+ */
+typedef struct {
+    uint32_t code;          // 32 bit frame
+    char key;               // Key character
+} irKey_t;
+
 // Function definitions
 extern void s4642286_irremote_init();
 extern void s4642286_irremote_recv();
 extern int s4642286_irremote_readkey();
+extern int s4642286_irremote_frame_get(irFrame_t *frame);
+extern void s4642286_irremote_notify_task(TaskHandle_t task);
+extern int s4642286_irremote_keymap_load(const irKey_t *map, int size);
+extern int s4642286_irremote_keymap_lookup(uint32_t code, char *value);
+
+/*
+ * When built with S4642286_IRREMOTE_DMA, TIM2 CH3 captures are copied by
+ * DMA1 Stream 1 (channel 3) into a circular buffer instead of interrupting
+ * on every edge, and are decoded in task context by
+ * s4642286_irremote_capture_process(), either from the IR remote task or
+ * from a main loop that runs at least every IR_CAPTURE_POLL ms.
+ * No other mylib driver uses DMA1 Stream 1 (the Hamming pipeline is on
+ * USART6 with DMA2 Streams 1 and 6), so the two can be used together.
+ */
+#ifdef S4642286_IRREMOTE_DMA
+extern void s4642286_irremote_capture_process(void);
+extern void s4642286_tsk_irremote_init(void);
+
+// Task Priority
+#define IRREMOTETASK_PRIORITY	( tskIDLE_PRIORITY + 3 )
+
+// Task Stack Size
+#define IRREMOTETASK_STACK_SIZE ( configMINIMAL_STACK_SIZE * 2 )
+
+// Capture buffer size, and the longest time (ms) between decoding the captures.
+#define IR_CAPTURE_BUFFER_SIZE 128
+#define IR_CAPTURE_POLL 10
+#endif
 
 // Global Variable Definitions for Key Presses
-int keyPressedFlag;
 char keyPressedValue;
 
+// Size of the received frame queue (must be a power of 2).
+#define IR_FRAME_QUEUE_SIZE 16
+
+/*
+ * Frames are decoded by the NEC decoder in s4642286_irremote_nec.c. Codes
+ * hold the first bit received in bit 31, so the digit codes below have the
+ * (inverse) address in the top 16 bits.
+ */
+
 // Define IR Remote Encoded Values
 #define ZERO 0xFF6897        
 #define ONE 0xFF30CF      
@@ -37,6 +101,6 @@ char keyPressedValue;
 #define EIGHT 0xFF4AB5         
 #define NINE 0xFF52AD
 
-#define TIMER_COUNTER_FREQ 50000
+#define TIMER_COUNTER_FREQ 1000000
 
 #endif
\ No newline at end of file
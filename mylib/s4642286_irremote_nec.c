@@ -0,0 +1,175 @@
+ /** 
+ **************************************************************
+ * @file mylib/s4642286_irremote_nec.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief NEC Infrared Protocol Decoder (hardware independent)
+ ***************************************************************
+ * EXTERNAL FUNCTIONS 
+ ***************************************************************
+ * s4642286_irremote_nec_init() - Resets an NEC decoder.
+ * s4642286_irremote_nec_edge() - Feeds one falling edge time to an NEC decoder
+ * 								  and returns any completed frame.
+ * s4642286_irremote_nec_valid() - Returns 1 if the address and command inverses
+ * 								   of a frame match, else 0.
+ *************************************************************** 
+ */
+
+#include "s4642286_irremote_nec.h"
+
+// NEC decoder states.
+#define NEC_IDLE 0      // Waiting for the start of a leader
+#define NEC_LEADER 1    // Leader started, waiting for the first data bit or repeat burst
+#define NEC_DATA 2      // Receiving the 32 data bits
+#define NEC_STATES 3
+
+// Classes of interval between falling edges.
+#define NEC_SYM_BIT0 0      // 1.125ms, logic 0
+#define NEC_SYM_BIT1 1      // 2.25ms, logic 1
+#define NEC_SYM_REPEAT 2    // 11.25ms, leader of a repeat code
+#define NEC_SYM_LEADER 3    // 13.5ms, leader of a frame
+#define NEC_SYM_OTHER 4     // Noise or a timeout
+#define NEC_SYMBOLS 5
+
+// Actions taken on a transition.
+#define NEC_ACT_NONE 0      // Nothing to do
+#define NEC_ACT_START 1     // Start collecting data bits
+#define NEC_ACT_BIT0 2      // Add a 0 bit
+#define NEC_ACT_BIT1 3      // Add a 1 bit
+#define NEC_ACT_REPEAT 4    // Report a repeat of the last frame
+
+/**
+ * @brief A struct for the accepted range of one class of interval (in us).
+ * 
+ */
+typedef struct {
+	uint32_t min;
+	uint32_t max;
+} necInterval_t;
+
+/**
+ * @brief A struct for one entry of the NEC state transition table.
+ * 
+ */
+typedef struct {
+	uint8_t next;       // Next state
+	uint8_t action;     // NEC_ACT_ value
+} necTransition_t;
+
+// Accepted intervals for each symbol (about +-20% of nominal, NEC_SYM_ order).
+static const necInterval_t necIntervals[NEC_SYM_OTHER] = {
+	{ 900, 1400 },      // NEC_SYM_BIT0
+	{ 1800, 2700 },     // NEC_SYM_BIT1
+	{ 10000, 12400 },   // NEC_SYM_REPEAT
+	{ 12400, 15000 }    // NEC_SYM_LEADER
+};
+
+/* Transitions for each state and interval. An edge that does not fit the
+ * current state (including a timeout) is taken as the start of a new leader. */
+static const necTransition_t necTransitions[NEC_STATES][NEC_SYMBOLS] = {
+	// NEC_IDLE: every edge starts a leader.
+	{ { NEC_LEADER, NEC_ACT_NONE }, { NEC_LEADER, NEC_ACT_NONE }, { NEC_LEADER, NEC_ACT_NONE },
+		{ NEC_LEADER, NEC_ACT_NONE }, { NEC_LEADER, NEC_ACT_NONE } },
+	// NEC_LEADER
+	{ { NEC_LEADER, NEC_ACT_NONE }, { NEC_LEADER, NEC_ACT_NONE }, { NEC_IDLE, NEC_ACT_REPEAT },
+		{ NEC_DATA, NEC_ACT_START }, { NEC_LEADER, NEC_ACT_NONE } },
+	// NEC_DATA
+	{ { NEC_DATA, NEC_ACT_BIT0 }, { NEC_DATA, NEC_ACT_BIT1 }, { NEC_LEADER, NEC_ACT_NONE },
+		{ NEC_DATA, NEC_ACT_START }, { NEC_LEADER, NEC_ACT_NONE } }
+};
+
+/**
+ * @brief This function resets an NEC decoder, so that it waits for a leader
+ * 		  and has no frame to repeat.
+ * 
+ * @param decoder the NEC decoder.
+ */
+void s4642286_irremote_nec_init(necDecoder_t *decoder) {
+	decoder->state = NEC_IDLE;
+	decoder->haveLastCode = 0;
+	decoder->bitCount = 0;
+	decoder->bitPattern = 0;
+	decoder->lastCode = 0;
+	decoder->lastFrameEdge = 0;
+	decoder->lastEdge = 0;
+}
+
+/**
+ * @brief This function checks a received frame. The address and command are
+ * 		  each followed by their inverse, so the second and fourth bytes must
+ * 		  be the inverse of the first and third.
+ * 
+ * @param code the 32 bit frame (first bit received in bit 31).
+ * @return int 1 if the frame is valid, else 0.
+ */
+int s4642286_irremote_nec_valid(uint32_t code) {
+	return ((((code >> 24) ^ (code >> 16)) & 0xFF) == 0xFF) &&
+		((((code >> 8) ^ code) & 0xFF) == 0xFF);
+}
+
+/**
+ * @brief This function runs the NEC state machine for one falling edge.
+ * 
+ * @param decoder the NEC decoder.
+ * @param edge the time of the falling edge (us, from a free running 32 bit counter).
+ * @param code receives the frame when NEC_FRAME or NEC_REPEAT is returned.
+ * @return int NEC_FRAME or NEC_REPEAT if this edge completed a valid frame or
+ * 		   repeat code, else NEC_NONE.
+ */
+int s4642286_irremote_nec_edge(necDecoder_t *decoder, uint32_t edge, uint32_t *code) {
+	const necTransition_t *transition;
+	uint32_t interval = edge - decoder->lastEdge;
+	int symbol, result = NEC_NONE;
+
+	decoder->lastEdge = edge;
+
+	// Classify the interval.
+	for (symbol = 0; symbol < NEC_SYM_OTHER; symbol++) {
+		if (interval >= necIntervals[symbol].min && interval < necIntervals[symbol].max) {
+			break;
+		}
+	}
+
+	transition = &necTransitions[decoder->state][symbol];
+	decoder->state = transition->next;
+
+	switch (transition->action) {
+		case NEC_ACT_START:
+			decoder->bitCount = 0;
+			decoder->bitPattern = 0;
+			break;
+
+		case NEC_ACT_BIT0:
+		case NEC_ACT_BIT1:
+			// Bits are placed from bit 31 down, to match the keymap codes.
+			if (transition->action == NEC_ACT_BIT1) {
+				decoder->bitPattern |= (uint32_t) 1 << (31 - decoder->bitCount);
+			}
+
+			if (++decoder->bitCount == 32) {
+				if (s4642286_irremote_nec_valid(decoder->bitPattern)) {
+					decoder->lastCode = decoder->bitPattern;
+					decoder->haveLastCode = 1;
+					decoder->lastFrameEdge = edge;
+					*code = decoder->bitPattern;
+					result = NEC_FRAME;
+				}
+				decoder->state = NEC_IDLE;
+			}
+			break;
+
+		case NEC_ACT_REPEAT:
+			// Only repeat a frame that was received recently.
+			if (decoder->haveLastCode && (edge - decoder->lastFrameEdge) <= NEC_REPEAT_TIMEOUT) {
+				decoder->lastFrameEdge = edge;
+				*code = decoder->lastCode;
+				result = NEC_REPEAT;
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	return result;
+}
@@ -0,0 +1,60 @@
+ /** 
+ **************************************************************
+ * @file mylib/s4642286_irremote_nec.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief NEC Infrared Protocol Decoder (hardware independent)
+ ***************************************************************
+ * EXTERNAL FUNCTIONS 
+ ***************************************************************
+ * s4642286_irremote_nec_init() - Resets an NEC decoder.
+ * s4642286_irremote_nec_edge() - Feeds one falling edge time to an NEC decoder.
+ * s4642286_irremote_nec_valid() - Checks the address and command inverses of a frame.
+ *************************************************************** 
+ */
+
+#ifndef S4642286_IRREMOTE_NEC_H
+#define S4642286_IRREMOTE_NEC_H
+
+#include <stdint.h>
+
+/*
+ * The decoder only sees the times (in us) of the falling edges of the
+ * receiver output, so it does not depend on the HAL, the timer or the RTOS.
+ * It is fed by the TIM2 capture ISR (or the DMA capture buffer) on the
+ * board, and can be fed recorded or synthetic edge times anywhere else.
+ *
+ * NEC frames are 32 bits, sent as address, inverse address, command and
+ * inverse command. Frames whose inverses do not match are rejected. Codes
+ * hold the first bit received in bit 31.
+ */
+
+// Results of feeding an edge to the decoder.
+#define NEC_NONE 0      // No frame completed
+#define NEC_FRAME 1     // A valid frame was received
+#define NEC_REPEAT 2    // A repeat code was received (the code is the last frame)
+
+// Repeat codes more than this long (us) after the last frame or repeat are ignored.
+#define NEC_REPEAT_TIMEOUT 150000
+
+/**
+ * @brief A struct for the state of an NEC decoder. The caller owns this
+ * 		  struct, so several decoders can run at once.
+ * 
+ */
+typedef struct {
+    uint8_t state;          // Current decoder state
+    uint8_t haveLastCode;   // 1 once a valid frame has been received
+    int bitCount;           // Data bits received in the current frame
+    uint32_t bitPattern;    // Data bits received in the current frame
+    uint32_t lastCode;      // Last valid frame, sent again for repeat codes
+    uint32_t lastFrameEdge; // Time of the last valid frame or repeat
+    uint32_t lastEdge;      // Time of the previous falling edge
+} necDecoder_t;
+
+// Function definitions
+extern void s4642286_irremote_nec_init(necDecoder_t *decoder);
+extern int s4642286_irremote_nec_edge(necDecoder_t *decoder, uint32_t edge, uint32_t *code);
+extern int s4642286_irremote_nec_valid(uint32_t code);
+
+#endif
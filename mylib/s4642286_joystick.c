@@ -11,7 +11,9 @@
  * s4642286_reg_joystick_pb_isr() - Joystick Pushbutton Interrupt service routine.
  * s4642286_reg_joystick_press_get() - Returns the value of the Joystick pushbutton press counter.
  * s4642286_reg_joystick_press_reset() - Reset the Joystick press counter value to 0.
- * s4642286_reg_joystick_init() - Intialise GPIO pins and ADC.
+ * s4642286_reg_joystick_press_duration_get() - Returns how long the last press was held.
+ * s4642286_reg_joystick_init() - Intialise GPIO pins, the ADC and DMA.
+ * s4642286_joystick_read() - Returns the averaged X or Y joystick value.
  * s4642286_tsk_joystick_init() - Creates the Joystick controlling task.
  *************************************************************** 
  */
@@ -24,10 +26,36 @@
 #include "semphr.h"
 #include "s4642286_joystick.h"
 #include "s4642286_CAG_joystick.h"
+#include <stdlib.h>
 
-// Global Variables for joystick press counter and falling edge time.
+// Global Variables for joystick press counter, falling edge time and press duration.
 static int joystickPressCounter;
 static uint32_t fallingEdgeTime;
+static uint32_t joystickPressDuration;
+
+// DMA2 Stream 0 channel 0 is connected to ADC1.
+#define DMA_CHANNEL_ADC1 (0x00 << 25)
+
+// ADC conversions written by DMA (X and Y alternate).
+static volatile uint16_t joystickSamples[JOYSTICK_ADC_SAMPLES * 2];
+
+/**
+ * @brief Internal function to (re)start DMA2 Stream 0 at the start of the
+ * 		  sample buffer, so that X and Y keep alternating from the first slot.
+ *
+ */
+static void joystick_dma_start(void) {
+	// DMA2 Stream 0: peripheral to memory, circular, half word transfers, no interrupts.
+	DMA2_Stream0->CR &= ~DMA_SxCR_EN;
+	while (DMA2_Stream0->CR & DMA_SxCR_EN);
+	DMA2->LIFCR = DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0;
+	DMA2_Stream0->PAR = (uint32_t) &ADC1->DR;
+	DMA2_Stream0->M0AR = (uint32_t) joystickSamples;
+	DMA2_Stream0->NDTR = JOYSTICK_ADC_SAMPLES * 2;
+	DMA2_Stream0->CR = DMA_CHANNEL_ADC1 | DMA_SxCR_PL_0 | DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 |
+		DMA_SxCR_MINC | DMA_SxCR_CIRC;
+	DMA2_Stream0->CR |= DMA_SxCR_EN;
+}
 
 /**
  * @brief The controlling task for the Joystick. This task uses semaphores
@@ -45,18 +73,39 @@ void s4642286TaskJoystick(void) {
 		pbSem = xSemaphoreCreateBinary();
 	}
 
+	// Filtered values (scaled by 2^JOYSTICK_FILTER_SHIFT) and the last values sent.
+	int filteredX = -1, filteredY = -1;
+	int sentX = -1, sentY = -1;
+	int x, y;
+
 	// Cyclic Executive (CE) loop
 	for (;;) {
 		// Check Joystick x and y values.
-		int x = S4642286_REG_JOYSTICK_X_READ();
-		int y = S4642286_REG_JOYSTICK_Y_READ();
+		x = S4642286_REG_JOYSTICK_X_READ();
+		y = S4642286_REG_JOYSTICK_Y_READ();
+
+		// Smooth the values with a moving average (first order low pass filter).
+		if (filteredX < 0) {
+			filteredX = x << JOYSTICK_FILTER_SHIFT;
+			filteredY = y << JOYSTICK_FILTER_SHIFT;
+		}
+		filteredX += x - (filteredX >> JOYSTICK_FILTER_SHIFT);
+		filteredY += y - (filteredY >> JOYSTICK_FILTER_SHIFT);
+		x = filteredX >> JOYSTICK_FILTER_SHIFT;
+		y = filteredY >> JOYSTICK_FILTER_SHIFT;
 
 		JoystickValues sendValues;
 
-		if (JoystickQueue != NULL) {
+		/* Only send the values when they have changed. The queue holds one
+		 * value, which is overwritten, so the receiver always gets the latest. */
+		if (JoystickQueue != NULL && (sentX < 0 || abs(x - sentX) >= JOYSTICK_CHANGE_MIN ||
+				abs(y - sentY) >= JOYSTICK_CHANGE_MIN)) {
 			sendValues.x_joystick = x;
 			sendValues.y_joystick = y;
-			xQueueSendToFront(JoystickQueue, ( void * ) &sendValues, ( portTickType ) 10);
+
+			xQueueOverwrite(JoystickQueue, ( void * ) &sendValues);
+			sentX = x;
+			sentY = y;
 		}
 		
 		// Delay the task for 10ms.
@@ -102,7 +151,9 @@ void s4642286_reg_joystick_pb_init(void) {
 
 
 /**
- * @brief Initialises GPIO analog pins PC0 and PC3 as analog inputs and configures ADC Channels.
+ * @brief Initialises GPIO analog pins PC0 and PC3 as analog inputs and configures ADC1
+ * 		  to convert both channels continuously. DMA2 Stream 0 copies every
+ * 		  conversion into a circular buffer, so the CPU never waits for the ADC.
  * 
  */
 void s4642286_reg_joystick_init(void) {
@@ -114,83 +165,73 @@ void s4642286_reg_joystick_init(void) {
 	GPIOC->PUPDR &= ~((0x03 << (0 * 2)) | (0x03 << (3 * 2)));							// Clear bits for no push/pull
 	GPIOC->MODER |= ((0x03 << (0 * 2)) | (0x03 << (3 * 2)));							// Set bits for analog input mode
 
-	// Enable ADC1 clock
+	// Enable ADC1 and DMA2 clocks
 	__ADC1_CLK_ENABLE();
-
-	adcHandlerX.Instance = (ADC_TypeDef *)(ADC1_BASE);						// Use ADC1
-	adcHandlerX.Init.ClockPrescaler        = ADC_CLOCKPRESCALER_PCLK_DIV2;	// Set clock prescaler
-	adcHandlerX.Init.Resolution            = ADC_RESOLUTION12b;				// Set 12-bit data resolution
-	adcHandlerX.Init.ScanConvMode          = DISABLE;
-	adcHandlerX.Init.ContinuousConvMode    = DISABLE;
-	adcHandlerX.Init.DiscontinuousConvMode = DISABLE;
-	adcHandlerX.Init.NbrOfDiscConversion   = 0;
-	adcHandlerX.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_NONE;	// No Trigger
-	adcHandlerX.Init.ExternalTrigConv      = ADC_EXTERNALTRIGCONV_T1_CC1;	// No Trigger
-	adcHandlerX.Init.DataAlign             = ADC_DATAALIGN_RIGHT;			// Right align data
-	adcHandlerX.Init.NbrOfConversion       = 1;
-	adcHandlerX.Init.DMAContinuousRequests = DISABLE;
-	adcHandlerX.Init.EOCSelection          = DISABLE;
-
-	HAL_ADC_Init(&adcHandlerX);		// Initialise ADC1
-
-	// Configure ADC Channel for Board pin A1
-	adcChanConfigX.Channel = ADC_CHANNEL_10;					// PC0 has Analog Channel 10 connected
-	adcChanConfigX.Rank         = 1;
-	adcChanConfigX.SamplingTime = ADC_SAMPLETIME_3CYCLES;
-	adcChanConfigX.Offset       = 0;
-
-	// Enable ADC2 clock
-	__ADC2_CLK_ENABLE();
-
-	adcHandlerY.Instance = (ADC_TypeDef *)(ADC2_BASE);						// Use ADC2
-	adcHandlerY.Init.ClockPrescaler        = ADC_CLOCKPRESCALER_PCLK_DIV2;	// Set clock prescaler
-	adcHandlerY.Init.Resolution            = ADC_RESOLUTION12b;				// Set 12-bit data resolution
-	adcHandlerY.Init.ScanConvMode          = DISABLE;
-	adcHandlerY.Init.ContinuousConvMode    = DISABLE;
-	adcHandlerY.Init.DiscontinuousConvMode = DISABLE;
-	adcHandlerY.Init.NbrOfDiscConversion   = 0;
-	adcHandlerY.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_NONE;	// No Trigger
-	adcHandlerY.Init.ExternalTrigConv      = ADC_EXTERNALTRIGCONV_T1_CC1;	// No Trigger
-	adcHandlerY.Init.DataAlign             = ADC_DATAALIGN_RIGHT;			// Right align data
-	adcHandlerY.Init.NbrOfConversion       = 1;
-	adcHandlerY.Init.DMAContinuousRequests = DISABLE;
-	adcHandlerY.Init.EOCSelection          = DISABLE;
-
-	HAL_ADC_Init(&adcHandlerY);		//Initialise ADC2
-
-	// Configure ADC Channel for Board pin A2
-	adcChanConfigY.Channel = ADC_CHANNEL_13;					// PC3 has Analog Channel 13 connected
-	adcChanConfigY.Rank         = 1;
-	adcChanConfigY.SamplingTime = ADC_SAMPLETIME_3CYCLES;
-	adcChanConfigY.Offset       = 0;
-
-	HAL_ADC_ConfigChannel(&adcHandlerX, &adcChanConfigX);		// Initialise ADC Channel for X input
-	HAL_ADC_ConfigChannel(&adcHandlerY, &adcChanConfigY);		// Initialise ADC Channel for Y input
+	__DMA2_CLK_ENABLE();
+
+	joystickAdcHandler.Instance = (ADC_TypeDef *)(ADC1_BASE);						// Use ADC1
+	joystickAdcHandler.Init.ClockPrescaler        = ADC_CLOCKPRESCALER_PCLK_DIV8;	// Set clock prescaler
+	joystickAdcHandler.Init.Resolution            = ADC_RESOLUTION12b;				// Set 12-bit data resolution
+	joystickAdcHandler.Init.ScanConvMode          = ENABLE;							// Convert both channels
+	joystickAdcHandler.Init.ContinuousConvMode    = ENABLE;							// Restart after each scan
+	joystickAdcHandler.Init.DiscontinuousConvMode = DISABLE;
+	joystickAdcHandler.Init.NbrOfDiscConversion   = 0;
+	joystickAdcHandler.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_NONE;	// No Trigger
+	joystickAdcHandler.Init.ExternalTrigConv      = ADC_EXTERNALTRIGCONV_T1_CC1;	// No Trigger
+	joystickAdcHandler.Init.DataAlign             = ADC_DATAALIGN_RIGHT;			// Right align data
+	joystickAdcHandler.Init.NbrOfConversion       = 2;
+	joystickAdcHandler.Init.DMAContinuousRequests = ENABLE;							// DMA request after every conversion
+	joystickAdcHandler.Init.EOCSelection          = DISABLE;
+
+	HAL_ADC_Init(&joystickAdcHandler);		// Initialise ADC1
+
+	// Configure ADC Channel for Board pin A1 (first in the scan)
+	joystickAdcChanConfigX.Channel = ADC_CHANNEL_10;					// PC0 has Analog Channel 10 connected
+	joystickAdcChanConfigX.Rank         = 1;
+	joystickAdcChanConfigX.SamplingTime = ADC_SAMPLETIME_480CYCLES;		// Slow sampling, about 11kHz per axis
+	joystickAdcChanConfigX.Offset       = 0;
+
+	// Configure ADC Channel for Board pin A2 (second in the scan)
+	joystickAdcChanConfigY.Channel = ADC_CHANNEL_13;					// PC3 has Analog Channel 13 connected
+	joystickAdcChanConfigY.Rank         = 2;
+	joystickAdcChanConfigY.SamplingTime = ADC_SAMPLETIME_480CYCLES;
+	joystickAdcChanConfigY.Offset       = 0;
+
+	HAL_ADC_ConfigChannel(&joystickAdcHandler, &joystickAdcChanConfigX);		// Initialise ADC Channel for X input
+	HAL_ADC_ConfigChannel(&joystickAdcHandler, &joystickAdcChanConfigY);		// Initialise ADC Channel for Y input
+
+	joystick_dma_start();
+
+	// Enable DMA requests, turn the ADC on and start converting.
+	ADC1->CR2 |= ADC_CR2_DMA | ADC_CR2_DDS;
+	ADC1->CR2 |= ADC_CR2_ADON;
+	ADC1->CR2 |= ADC_CR2_SWSTART;
 }
 
 
 /**
- * @brief This function reads and returns the X or Y joystick value.
+ * @brief This function returns the X or Y joystick value, averaged over the
+ * 		  last JOYSTICK_ADC_SAMPLES conversions in the DMA buffer.
+ * 		  -> If the DMA missed a conversion (ADC overrun), the ADC stops making
+ * 		  DMA requests and the buffer goes stale, so the stream is restarted
+ * 		  first (RM0090: reload the DMA, clear OVR, start the conversions).
  * 
- * @param adcHandler The ADC Handler for the X or Y joystick analog input. 
+ * @param axis JOYSTICK_AXIS_X or JOYSTICK_AXIS_Y.
  * @return int The X or Y joystick ADC value.
  */
-int s4642286_joystick_readxy(ADC_HandleTypeDef adcHandler) {
-	int adcValue;
+int s4642286_joystick_read(int axis) {
+	int i, sum = 0;
 
-	HAL_ADC_Start(&adcHandler); // Start ADC conversion
+	if ((ADC1->SR & ADC_SR_OVR) == ADC_SR_OVR) {
+		joystick_dma_start();
+		ADC1->SR = ~ADC_SR_OVR;			// Status bits are cleared by writing 0
+		ADC1->CR2 |= ADC_CR2_SWSTART;
+	}
 
-	// Wait for ADC conversion to finish
-	while (HAL_ADC_PollForConversion(&adcHandler, 10) != HAL_OK);
-	if (adcHandler.Instance == (ADC_TypeDef *)ADC1_BASE) {
-		// Read converted value from ADC1 Data Register
-		adcValue = ADC1->DR;
-		
-	} else if (adcHandler.Instance == (ADC_TypeDef *)ADC2_BASE) {
-		// Read converted value from ADC2 Data Register
-		adcValue = ADC2->DR;
+	for (i = axis; i < JOYSTICK_ADC_SAMPLES * 2; i += 2) {
+		sum += joystickSamples[i];
 	}
-	return adcValue;
+	return sum / JOYSTICK_ADC_SAMPLES;
 }
 
 
@@ -211,6 +252,7 @@ void s4642286_reg_joystick_pb_isr(void) {
         if ((HAL_GetTick() - fallingEdgeTime) > 20) {
             // Button is high again (button been released)
 			joystickPressCounter++;
+			joystickPressDuration = HAL_GetTick() - fallingEdgeTime;
 			
 			// Is it time for another Task() to run?
 			xHigherPriorityTaskWoken = pdFALSE;
@@ -251,6 +293,15 @@ int s4642286_reg_joystick_press_get(void) {
 	return joystickPressCounter;
 }
 
+/**
+ * @brief This function returns how long the last joystick press was held.
+ * 
+ * @return uint32_t - returns the duration of the last press (ms).
+ */
+uint32_t s4642286_reg_joystick_press_duration_get(void) {
+	return joystickPressDuration;
+}
+
 /**
  * @brief This function resets the joystick press counter to 0.
  * 
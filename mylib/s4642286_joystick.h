@@ -11,7 +11,9 @@
  * s4642286_reg_joystick_pb_isr() - Joystick Pushbutton Interrupt service routine.
  * s4642286_reg_joystick_press_get() - Returns the value of the Joystick pushbutton press counter.
  * s4642286_reg_joystick_press_reset() - Reset the Joystick event counter value to 0.
- * s4642286_reg_joystick_init() - Intialise GPIO pins and ADC.
+ * s4642286_reg_joystick_press_duration_get() - Returns how long the last press was held.
+ * s4642286_reg_joystick_init() - Intialise GPIO pins, the ADC and DMA.
+ * s4642286_joystick_read() - Returns the averaged X or Y joystick value.
  * s4642286_tsk_joystick_init() - Creates the Joystick controlling task.
  *************************************************************** 
  */
@@ -26,9 +28,10 @@ extern void s4642286_reg_joystick_pb_init(void);
 extern void s4642286_reg_joystick_pb_isr(void);
 extern int s4642286_reg_joystick_press_get(void);
 extern void s4642286_reg_joystick_press_reset(void);
+extern uint32_t s4642286_reg_joystick_press_duration_get(void);
 extern void s4642286_reg_joystick_init(void);
 extern void s4642286_tsk_joystick_init(void);
-int s4642286_joystick_readxy(ADC_HandleTypeDef adcHandler);
+extern int s4642286_joystick_read(int axis);
 
 // Task Priority
 #define JOYSTICKTASK_PRIORITY	( tskIDLE_PRIORITY + 4 )
@@ -39,15 +42,27 @@ int s4642286_joystick_readxy(ADC_HandleTypeDef adcHandler);
 // Joystick Pushbutton Semaphore to control timers.
 SemaphoreHandle_t pbSem;
 
-// Global Variable declarations for ADC Handlers and Channel Configurations.
-ADC_HandleTypeDef adcHandlerX;
-ADC_HandleTypeDef adcHandlerY;
-ADC_ChannelConfTypeDef adcChanConfigX;
-ADC_ChannelConfTypeDef adcChanConfigY;
+// Global Variable declarations for the ADC Handler and Channel Configurations.
+ADC_HandleTypeDef joystickAdcHandler;
+ADC_ChannelConfTypeDef joystickAdcChanConfigX;
+ADC_ChannelConfTypeDef joystickAdcChanConfigY;
+
+// Joystick axes (position of each axis in the ADC scan).
+#define JOYSTICK_AXIS_X 0
+#define JOYSTICK_AXIS_Y 1
+
+// Number of conversions of each axis kept in the DMA buffer and averaged.
+#define JOYSTICK_ADC_SAMPLES 16
+
+// Moving average filter strength (each new value has a weight of 1/2^shift).
+#define JOYSTICK_FILTER_SHIFT 2
+
+// Smallest change in a filtered value that is sent to JoystickQueue.
+#define JOYSTICK_CHANGE_MIN 4
 
 // Macro Function Definitions
-#define S4642286_REG_JOYSTICK_X_READ() (s4642286_joystick_readxy(adcHandlerX))
-#define S4642286_REG_JOYSTICK_Y_READ() (s4642286_joystick_readxy(adcHandlerY))
+#define S4642286_REG_JOYSTICK_X_READ() (s4642286_joystick_read(JOYSTICK_AXIS_X))
+#define S4642286_REG_JOYSTICK_Y_READ() (s4642286_joystick_read(JOYSTICK_AXIS_Y))
 
 // Define Configuration Parameters
 #define S4642286_REG_JOYSTICK_X_ZERO_CAL_OFFSET 10
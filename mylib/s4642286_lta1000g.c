@@ -10,6 +10,10 @@
  * s4642286_reg_lta1000g_init() - Intialise LED Bar
  * s4642286_reg_lta1000g_write() - Write the LED Bar segments high or low. 
  * s4642286_tsk_lta1000g_init() - Creates the LED Bar controlling task.
+ * s4642286_reg_lta1000g_pwm_init() - Starts the TIM3 software PWM renderer.
+ * s4642286_lta1000g_brightness_set() - Sets the brightness of one segment.
+ * s4642286_lta1000g_pattern_set() - Shows a bit pattern at one brightness.
+ * s4642286_lta1000g_bar_set() - Shows a value as a bar graph.
  *************************************************************** 
  */
 #include "board.h"
@@ -20,9 +24,79 @@
 #include "semphr.h"
 #include "s4642286_lta1000g.h"
 
+// Segment n is driven by pin segmentPins[n] of segmentPorts[n].
+static GPIO_TypeDef * const segmentPorts[LTA1000G_SEGMENTS] = {
+    GPIOC, GPIOB, GPIOB, GPIOB, GPIOA, GPIOC, GPIOB, GPIOB, GPIOA, GPIOB
+};
+static const unsigned char segmentPins[LTA1000G_SEGMENTS] = {
+    6, 15, 13, 12, 15, 7, 5, 3, 4, 4
+};
+
+/* BSRR word that sets (bit n of value is 1) or resets (0) a pin. The upper
+ * half of BSRR resets pins, the lower half sets them. */
+#define SEG_BSRR(value, n, pin) ((((value) >> (n)) & 0x01) ? (0x01UL << (pin)) : (0x01UL << ((pin) + 16)))
+
+// BSRR words for each port, for segments 0-4 (low) and 5-9 (high) of a value.
+#define LOW_HALF(v) { SEG_BSRR(v, 4, 15), \
+        SEG_BSRR(v, 1, 15) | SEG_BSRR(v, 2, 13) | SEG_BSRR(v, 3, 12), \
+        SEG_BSRR(v, 0, 6) }
+#define HIGH_HALF(v) { SEG_BSRR(v, 3, 4), \
+        SEG_BSRR(v, 1, 5) | SEG_BSRR(v, 2, 3) | SEG_BSRR(v, 4, 4), \
+        SEG_BSRR(v, 0, 7) }
+
+// BSRR bits of the probe pins on each port, which writes must not change.
+#ifdef S4642286_LTA1000G_PROBE
+#define PROBE_BSRR(pin) (0x00010001UL << (pin))
+#define PROBE_MASK_A PROBE_BSRR(PROBE_DISPLAY_FLUSH_PIN)
+#define PROBE_MASK_B (PROBE_BSRR(PROBE_SIM_GENERATION_PIN) | PROBE_BSRR(PROBE_CLI_COMMAND_PIN))
+#else
+#define PROBE_MASK_A 0
+#define PROBE_MASK_B 0
+#endif
+
+// Render modes of the software PWM.
+#define PWM_MODE_PATTERN 0  // Brightness buffer is set directly
+#define PWM_MODE_BAR 1      // Brightness buffer is drawn from barLevel
+
+/* Shared buffer read by the TIM3 ISR. Segment n is on for brightness[n] of
+ * every LTA1000G_PWM_LEVELS steps. Bar levels are in 1/LTA1000G_PWM_LEVELS
+ * of a segment. */
+static volatile unsigned char brightness[LTA1000G_SEGMENTS];
+static volatile int pwmMode;
+static volatile int barLevel;
+static int pwmStep;
+
+/**
+ * @brief A struct for the BSRR words of the three LED Bar ports.
+ * 
+ */
+typedef struct {
+    uint32_t portA;
+    uint32_t portB;
+    uint32_t portC;
+} lta1000gBsrr_t;
+
+/* BSRR words for every 5 segment pattern, generated by the compiler. A full
+ * value combines one entry from each table. */
+static const lta1000gBsrr_t lowHalfBsrr[32] = {
+    LOW_HALF(0), LOW_HALF(1), LOW_HALF(2), LOW_HALF(3), LOW_HALF(4), LOW_HALF(5), LOW_HALF(6), LOW_HALF(7),
+    LOW_HALF(8), LOW_HALF(9), LOW_HALF(10), LOW_HALF(11), LOW_HALF(12), LOW_HALF(13), LOW_HALF(14), LOW_HALF(15),
+    LOW_HALF(16), LOW_HALF(17), LOW_HALF(18), LOW_HALF(19), LOW_HALF(20), LOW_HALF(21), LOW_HALF(22), LOW_HALF(23),
+    LOW_HALF(24), LOW_HALF(25), LOW_HALF(26), LOW_HALF(27), LOW_HALF(28), LOW_HALF(29), LOW_HALF(30), LOW_HALF(31)
+};
+static const lta1000gBsrr_t highHalfBsrr[32] = {
+    HIGH_HALF(0), HIGH_HALF(1), HIGH_HALF(2), HIGH_HALF(3), HIGH_HALF(4), HIGH_HALF(5), HIGH_HALF(6), HIGH_HALF(7),
+    HIGH_HALF(8), HIGH_HALF(9), HIGH_HALF(10), HIGH_HALF(11), HIGH_HALF(12), HIGH_HALF(13), HIGH_HALF(14), HIGH_HALF(15),
+    HIGH_HALF(16), HIGH_HALF(17), HIGH_HALF(18), HIGH_HALF(19), HIGH_HALF(20), HIGH_HALF(21), HIGH_HALF(22), HIGH_HALF(23),
+    HIGH_HALF(24), HIGH_HALF(25), HIGH_HALF(26), HIGH_HALF(27), HIGH_HALF(28), HIGH_HALF(29), HIGH_HALF(30), HIGH_HALF(31)
+};
+
 /**
  * @brief The controlling task for the LED Bar. It uses a queue to 
- *        recieve information from other tasks.
+ *        recieve information from other tasks: the cursor position is shown
+ *        as a pattern and the simulation population as a bar graph.
+ *        -> The cursor has priority. The population is only drawn once the
+ *        cursor has not moved for LTA1000G_CURSOR_HOLD_MS.
  * 
  */
 void s4642286TaskLEDBar(void) {
@@ -32,15 +106,31 @@ void s4642286TaskLEDBar(void) {
     // Create a struct to hold recieved message.
     xyposition recievePosition;
 
+    // Tick of the last cursor position, and whether one has been shown.
+    TickType_t cursorTick = 0;
+    int cursorShown = 0;
+
 	// Create a Queue
 	positionQueue = xQueueCreate(10, sizeof(recievePosition));
 
+    // The LED Bar is drawn by the TIM3 ISR from here on.
+    s4642286_reg_lta1000g_pwm_init();
+
 	for (;;) {
 
         if (positionQueue != NULL) {
             if (xQueueReceive( positionQueue, &recievePosition, 10 )) {
-                // Write position to led bar.
-				s4642286_reg_lta1000g_write(recievePosition.value);
+                if (recievePosition.max == 0) {
+                    // Write position to led bar.
+                    s4642286_lta1000g_pattern_set(recievePosition.value, LTA1000G_PWM_LEVELS);
+                    cursorTick = xTaskGetTickCount();
+                    cursorShown = 1;
+                } else if (!cursorShown ||
+                        (xTaskGetTickCount() - cursorTick) >= LTA1000G_CURSOR_HOLD_MS) {
+                    // Draw the population as a bar graph while the cursor is idle.
+                    s4642286_lta1000g_bar_set(recievePosition.value, recievePosition.max);
+                    cursorShown = 0;
+                }
         	}
         }
 
@@ -92,103 +182,189 @@ void s4642286_reg_lta1000g_init(void) {
  * @param segment_value - the value of the segment (0 or 1).
  */
 void lta1000g_set_seg(int segment, unsigned char segment_value) {
-    switch (segment) {
-        case 0:
-            if (segment_value) {
-                GPIOC->ODR |= (0x01 << 6);   // Set bit
-            } else {
-                GPIOC->ODR &= ~(0x01 << 6);   // Clear bit
-            }
-            break;
-
-        case 1:
-            if (segment_value) {
-                GPIOB->ODR |= (0x01 << 15);   // Set bit
-            } else {
-                GPIOB->ODR &= ~(0x01 << 15);   // Clear bit
-            }
-            break;
-
-        case 2:
-            if (segment_value) {
-                GPIOB->ODR |= (0x01 << 13);   // Set bit
-            } else {
-                GPIOB->ODR &= ~(0x01 << 13);   // Clear bit
-            }
-            break;
-
-        case 3:
-            if (segment_value) {
-                GPIOB->ODR |= (0x01 << 12);   // Set bit
-            } else {
-                GPIOB->ODR &= ~(0x01 << 12);   // Clear bit
-            }
-            break;
-    
-        case 4:
-            if (segment_value) {
-                GPIOA->ODR |= (0x01 << 15);   // Set bit
-            } else {
-                GPIOA->ODR &= ~(0x01 << 15);   // Clear bit
-            }
-            break;
-    
-        case 5:
-            if (segment_value) {
-                GPIOC->ODR |= (0x01 << 7);   // Set bit
-            } else {
-                GPIOC->ODR &= ~(0x01 << 7);   // Clear bit
-            }
-            break;
-        
-        case 6:
-            if (segment_value) {
-                GPIOB->ODR |= (0x01 << 5);   // Set bit
-            } else {
-                GPIOB->ODR &= ~(0x01 << 5);   // Clear bit
-            }
-            break;
-
-        case 7:
-            if (segment_value) {
-                GPIOB->ODR |= (0x01 << 3);   // Set bit
-            } else {
-                GPIOB->ODR &= ~(0x01 << 3);   // Clear bit
-            }
-            break;
-
-        case 8:
-            if (segment_value) {
-                GPIOA->ODR |= (0x01 << 4);   // Set bit
-            } else {
-                GPIOA->ODR &= ~(0x01 << 4);   // Clear bit
-            }
-            break;
-
-        case 9:
-            if (segment_value) {
-                GPIOB->ODR |= (0x01 << 4);   // Set bit
-            } else {
-                GPIOB->ODR &= ~(0x01 << 4);   // Clear bit
-            }
-            break;
+    if (segment < 0 || segment >= LTA1000G_SEGMENTS) {
+        return;
+    }
+
+#ifdef S4642286_LTA1000G_PROBE
+    // Probe segments are only driven by the probe macros.
+    if (segment >= 7) {
+        return;
     }
+#endif
 
+    // A single BSRR write sets or clears the pin without touching the others.
+    if (segment_value) {
+        segmentPorts[segment]->BSRR = (0x01UL << segmentPins[segment]);
+    } else {
+        segmentPorts[segment]->BSRR = (0x01UL << (segmentPins[segment] + 16));
+    }
 }
 
 /**
  * @brief Update the whole LED Bar and change each segment to high or low.
+ *        -> Each port is updated with one BSRR write, so the update is three
+ *        atomic writes and does not disturb other pins on the ports.
+ *        -> In probe builds the probe segments are left unchanged.
  * 
  * @param value - a binary number which holds the state of each segment.
  */
 void s4642286_reg_lta1000g_write(unsigned short value) {
-    // Iterate through each digit in value to see if segment is high or low.
-    for (int seg = 0; seg < 10; seg++) {
-        if (((value & (0x0001 << seg)) == (0x0001 << seg))) {
-            lta1000g_set_seg(seg, 1);
-        } else {
-            lta1000g_set_seg(seg, 0);
+    const lta1000gBsrr_t *low = &lowHalfBsrr[value & 0x1F];
+    const lta1000gBsrr_t *high = &highHalfBsrr[(value >> 5) & 0x1F];
+
+    GPIOA->BSRR = (low->portA | high->portA) & ~PROBE_MASK_A;
+    GPIOB->BSRR = (low->portB | high->portB) & ~PROBE_MASK_B;
+    GPIOC->BSRR = low->portC | high->portC;
+}
+
+/**
+ * @brief Initialises TIM3 to interrupt LTA1000G_PWM_LEVELS times per PWM
+ *        frame. The ISR then owns the LED Bar, so s4642286_reg_lta1000g_write()
+ *        should no longer be called.
+ * 
+ */
+void s4642286_reg_lta1000g_pwm_init(void) {
+    int i;
+
+    for (i = 0; i < LTA1000G_SEGMENTS; i++) {
+        brightness[i] = 0;
+    }
+    pwmMode = PWM_MODE_PATTERN;
+    pwmStep = 0;
+
+    // Enable the TIM3 clock.
+    __TIM3_CLK_ENABLE();
+
+    // Count at 1MHz (APB1 timer clock is SystemCoreClock / 2).
+    TIM3->PSC = ((SystemCoreClock / 2) / LTA1000G_PWM_TIMER_FREQ) - 1;
+    TIM3->ARR = (LTA1000G_PWM_TIMER_FREQ / (LTA1000G_PWM_FRAME_HZ * LTA1000G_PWM_LEVELS)) - 1;
+    TIM3->CNT = 0;
+    TIM3->DIER |= TIM_DIER_UIE;     // Enable the update interrupt
+
+    // Enable the lowest priority (15), so the renderer never delays other interrupts.
+    HAL_NVIC_SetPriority(TIM3_IRQn, 15, 0);
+    HAL_NVIC_EnableIRQ(TIM3_IRQn);
+
+    TIM3->CR1 |= TIM_CR1_CEN;       // Enable the counter
+}
+
+/**
+ * @brief Internal function to change the render mode.
+ * 
+ * @param mode - the new render mode.
+ */
+static void lta1000g_mode_set(int mode) {
+    pwmMode = mode;
+}
+
+/**
+ * @brief Sets the brightness of one segment.
+ * 
+ * @param segment - the segment (0 to 9).
+ * @param level - the brightness (0 is off, LTA1000G_PWM_LEVELS is fully on).
+ */
+void s4642286_lta1000g_brightness_set(int segment, int level) {
+    if (segment < 0 || segment >= LTA1000G_SEGMENTS) {
+        return;
+    }
+
+    if (level < 0) {
+        level = 0;
+    } else if (level > LTA1000G_PWM_LEVELS) {
+        level = LTA1000G_PWM_LEVELS;
+    }
+
+    lta1000g_mode_set(PWM_MODE_PATTERN);
+    brightness[segment] = level;
+}
+
+/**
+ * @brief Shows a bit pattern, with the set segments at one brightness.
+ * 
+ * @param value - a binary number which holds the state of each segment.
+ * @param level - the brightness of the set segments.
+ */
+void s4642286_lta1000g_pattern_set(unsigned short value, int level) {
+    int seg;
+
+    for (seg = 0; seg < LTA1000G_SEGMENTS; seg++) {
+        s4642286_lta1000g_brightness_set(seg, (value & (0x01 << seg)) ? level : 0);
+    }
+}
+
+/**
+ * @brief Internal function to convert a value to a bar level.
+ * 
+ * @param value - the value to show (clamped to 0 to max).
+ * @param max - the value that lights the whole bar.
+ * @return int - the bar level, in 1/LTA1000G_PWM_LEVELS of a segment.
+ */
+static int lta1000g_bar_level(int value, int max) {
+    if (max <= 0 || value <= 0) {
+        return 0;
+    } else if (value >= max) {
+        return LTA1000G_SEGMENTS * LTA1000G_PWM_LEVELS;
+    }
+    return (value * LTA1000G_SEGMENTS * LTA1000G_PWM_LEVELS) / max;
+}
+
+/**
+ * @brief Shows a value as a bar graph from segment 0. The top segment is
+ *        dimmed in proportion to the part of it that is filled.
+ * 
+ * @param value - the value to show (e.g. simulation population).
+ * @param max - the value that lights the whole bar.
+ */
+void s4642286_lta1000g_bar_set(int value, int max) {
+    barLevel = lta1000g_bar_level(value, max);
+    lta1000g_mode_set(PWM_MODE_BAR);
+}
+
+/**
+ * @brief Internal function to draw the bar into the brightness buffer.
+ *        Called from the TIM3 ISR at the start of each PWM frame.
+ * 
+ */
+static void lta1000g_bar_render(void) {
+    int level = barLevel;
+    int seg, fill;
+
+    for (seg = 0; seg < LTA1000G_SEGMENTS; seg++) {
+        fill = level - (seg * LTA1000G_PWM_LEVELS);
+
+        if (fill < 0) {
+            fill = 0;
+        } else if (fill > LTA1000G_PWM_LEVELS) {
+            fill = LTA1000G_PWM_LEVELS;
         }
-    } 
+        brightness[seg] = fill;
+    }
 }
 
+/**
+ * @brief Interrupt handler (ISR) for TIM 3 IRQ Handler. Each interrupt is one
+ *        PWM step, and the segments brighter than the step are lit with the
+ *        three BSRR writes of s4642286_reg_lta1000g_write().
+ * 
+ */
+void TIM3_IRQHandler(void) {
+    unsigned short value = 0;
+    int seg;
+
+    // Clear the update interrupt flag.
+    TIM3->SR &= ~TIM_SR_UIF;
+
+    if (pwmStep == 0 && pwmMode != PWM_MODE_PATTERN) {
+        lta1000g_bar_render();
+    }
+
+    for (seg = 0; seg < LTA1000G_SEGMENTS; seg++) {
+        if (brightness[seg] > pwmStep) {
+            value |= (0x01 << seg);
+        }
+    }
+    s4642286_reg_lta1000g_write(value);
+
+    pwmStep = (pwmStep + 1) % LTA1000G_PWM_LEVELS;
+}
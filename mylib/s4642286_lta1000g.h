@@ -10,6 +10,10 @@
  * s4642286_reg_lta1000g_init() - Intialise LED Bar
  * s4642286_reg_lta1000g_write() - Write the LED Bar segments high or low
  * s4642286_tsk_lta1000g_init() - Creates the LED Bar controlling task.
+ * s4642286_reg_lta1000g_pwm_init() - Starts the TIM3 software PWM renderer.
+ * s4642286_lta1000g_brightness_set() - Sets the brightness of one segment.
+ * s4642286_lta1000g_pattern_set() - Shows a bit pattern at one brightness.
+ * s4642286_lta1000g_bar_set() - Shows a value as a bar graph.
  *************************************************************** 
  */
 
@@ -20,6 +24,40 @@
 extern void s4642286_reg_lta1000g_init(void);
 extern void s4642286_reg_lta1000g_write(unsigned short value);
 extern void s4642286_tsk_lta1000g_init(void);
+extern void s4642286_reg_lta1000g_pwm_init(void);
+extern void s4642286_lta1000g_brightness_set(int segment, int level);
+extern void s4642286_lta1000g_pattern_set(unsigned short value, int level);
+extern void s4642286_lta1000g_bar_set(int value, int max);
+
+// Number of LED Bar segments.
+#define LTA1000G_SEGMENTS 10
+
+// Software PWM: TIM3 steps through LTA1000G_PWM_LEVELS brightness levels per frame.
+#define LTA1000G_PWM_TIMER_FREQ 1000000
+#define LTA1000G_PWM_FRAME_HZ 200
+#define LTA1000G_PWM_LEVELS 32
+
+// Time (ms) the cursor stays on the LED Bar before the population is drawn again.
+#define LTA1000G_CURSOR_HOLD_MS 2000
+
+/* Probe points for timing with a logic analyser. Build with
+ * S4642286_LTA1000G_PROBE defined and each probe segment is high while its
+ * event runs, using one BSRR write at each end. The LED Bar write functions
+ * then leave the probe segments alone. */
+#define PROBE_SIM_GENERATION_PORT GPIOB     // Segment 7 (PB3) - simulator generation
+#define PROBE_SIM_GENERATION_PIN 3
+#define PROBE_DISPLAY_FLUSH_PORT GPIOA      // Segment 8 (PA4) - CAG display flush
+#define PROBE_DISPLAY_FLUSH_PIN 4
+#define PROBE_CLI_COMMAND_PORT GPIOB        // Segment 9 (PB4) - CLI command output chunk
+#define PROBE_CLI_COMMAND_PIN 4
+
+#ifdef S4642286_LTA1000G_PROBE
+#define LTA1000G_PROBE_START(probe) (probe##_PORT->BSRR = (0x01UL << probe##_PIN))
+#define LTA1000G_PROBE_END(probe) (probe##_PORT->BSRR = (0x01UL << (probe##_PIN + 16)))
+#else
+#define LTA1000G_PROBE_START(probe) ((void) 0)
+#define LTA1000G_PROBE_END(probe) ((void) 0)
+#endif
 
 // Task Priority
 #define LEDTASK_PRIORITY	( tskIDLE_PRIORITY + 4 )
@@ -27,8 +65,12 @@ extern void s4642286_tsk_lta1000g_init(void);
 // Task Stack Size
 #define LEDTASK_STACK_SIZE ( configMINIMAL_STACK_SIZE * 2 )
 
+/* A max of 0 shows value as a segment pattern (the cursor position), otherwise
+ * value is shown as a bar graph out of max (the simulation population). The
+ * bar graph is ignored for LTA1000G_CURSOR_HOLD_MS after a cursor position. */
 typedef struct {
     unsigned short value;
+    unsigned short max;
 } xyposition;
 
 // Queue Handle for LED Bar to communicate with CAG Simulator.
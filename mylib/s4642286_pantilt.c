@@ -8,21 +8,171 @@
  * EXTERNAL FUNCTIONS 
  ***************************************************************
  * s4642286_reg_pantilt_init() - Initialise servo (GPIO, PWM, etc)
+ * s4642286_pantilt_angle_write() - Moves a servo straight to an angle.
+ * s4642286_pantilt_angle_read() - Returns the current angle of a servo.
+ * s4642286_pantilt_target_set() - Sets the angle a servo moves smoothly to.
+ * s4642286_pantilt_calibrate() - Loads the calibration table of a servo.
+ * s4642286_tsk_pantilt_init() - Creates the pan/tilt joystick tracking task.
  *************************************************************** 
  */
 
 #include "board.h"
 #include "processor_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "s4642286_joystick.h"
 #include "s4642286_pantilt.h"
+#include <stddef.h>
 
-// Timer Macro Definitions
-#define TIMER_COUNTING_FREQ 50000
-#define PWM_PULSE_WIDTH_TICKS 2000
-#define PWM_PERCENT2TICKS_DUTYCYCLE(value) (uint16_t)(value * PWM_PULSE_WIDTH_TICKS / 100)
-#define PWM_TICKS2PERCENT_DUTYCYCLE(value) (double)((100.0 / (double)PWM_PULSE_WIDTH_TICKS) * value)
-#define DUTYCYCLE_TO_ANGLE(dutyCycle) (int)((18 * dutyCycle) - 130.5)
-#define ANGLE_TO_DUTYCYCLE(angle) (double)((1.0/18.0) * (double)angle + 7.25)
-#define ZERO_DUTY_CYCLE 7.25
+// Timer Macro Definitions (20 times the previous 50kHz resolution, same period).
+#define TIMER_COUNTING_FREQ 1000000
+#define PWM_PULSE_WIDTH_TICKS 40000
+
+/* Nominal servo ticks at the calibration angles (-90, -45, 0, 45 and 90
+ * degrees): duty cycle = angle / 18 + 7.25%, so 1000 ticks per 45 degrees. */
+#define PANTILT_NOMINAL_CAL { 900, 1900, 2900, 3900, 4900 }
+
+// Trajectory positions and velocities are fixed point, in 1/256 ticks.
+#define Q8(ticks) ((ticks) << 8)
+
+/**
+ * @brief A struct for the trajectory of one servo.
+ * 
+ */
+typedef struct {
+	volatile int target;	// Target position (1/256 ticks)
+	int position;			// Current position (1/256 ticks)
+	int velocity;			// Current velocity (1/256 ticks per PWM period)
+} pantiltAxis_t;
+
+static pantiltAxis_t pantiltAxes[2];
+static int pantiltCal[2][PANTILT_CAL_POINTS] = { PANTILT_NOMINAL_CAL, PANTILT_NOMINAL_CAL };
+
+/**
+ * @brief Internal function to convert an angle to servo ticks, by linear
+ * 		  interpolation of the calibration table.
+ * 
+ * @param type Type is 0 for pan or 1 for tilt
+ * @param angle the angle (clamped to -90 to 90 degrees)
+ * @return int the number of ticks
+ */
+static int pantilt_angle_to_ticks(int type, int angle) {
+	const int *cal = pantiltCal[type];
+	int i;
+
+	if (angle < PANTILT_ANGLE_MIN) {
+		angle = PANTILT_ANGLE_MIN;
+	} else if (angle > PANTILT_ANGLE_MAX) {
+		angle = PANTILT_ANGLE_MAX;
+	}
+
+	// Find the calibration interval holding the angle.
+	i = (angle - PANTILT_ANGLE_MIN) / PANTILT_CAL_STEP;
+	if (i > PANTILT_CAL_POINTS - 2) {
+		i = PANTILT_CAL_POINTS - 2;
+	}
+	angle -= PANTILT_ANGLE_MIN + (i * PANTILT_CAL_STEP);
+
+	return cal[i] + ((cal[i + 1] - cal[i]) * angle) / PANTILT_CAL_STEP;
+}
+
+/**
+ * @brief Internal function to convert servo ticks to the nearest angle, by
+ * 		  linear interpolation of the calibration table.
+ * 
+ * @param type Type is 0 for pan or 1 for tilt
+ * @param ticks the number of ticks
+ * @return int the angle
+ */
+static int pantilt_ticks_to_angle(int type, int ticks) {
+	const int *cal = pantiltCal[type];
+	int i, span;
+
+	// Find the calibration interval holding the ticks (tables may decrease).
+	for (i = 0; i < PANTILT_CAL_POINTS - 2; i++) {
+		if ((cal[i + 1] >= cal[i]) ? (ticks < cal[i + 1]) : (ticks > cal[i + 1])) {
+			break;
+		}
+	}
+
+	span = cal[i + 1] - cal[i];
+	if (span == 0) {
+		return PANTILT_ANGLE_MIN + (i * PANTILT_CAL_STEP);
+	}
+	return PANTILT_ANGLE_MIN + (i * PANTILT_CAL_STEP) +
+		((2 * (ticks - cal[i]) * PANTILT_CAL_STEP + span) / (2 * span));
+}
+
+/**
+ * @brief Internal function to calculate an integer square root.
+ * 
+ * @param value the value
+ * @return int the largest integer whose square is at most value
+ */
+static int pantilt_isqrt(uint32_t value) {
+	uint32_t root = 0, bit = 1UL << 30;
+
+	while (bit > value) {
+		bit >>= 2;
+	}
+	while (bit != 0) {
+		if (value >= root + bit) {
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		} else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+	return root;
+}
+
+/**
+ * @brief Internal function to move one servo a PWM period along its
+ * 		  trajectory. The velocity changes by at most PANTILT_MAX_ACCEL and is
+ * 		  limited to PANTILT_MAX_VELOCITY, and to the speed that can still stop
+ * 		  at the target (v^2 = 2 * a * distance).
+ * 
+ * @param axis the servo trajectory
+ * @return int the number of ticks to write to the CCR register
+ */
+static int pantilt_axis_update(pantiltAxis_t *axis) {
+	int error = axis->target - axis->position;
+	int distance = (error < 0) ? -error : error;
+	int desired;
+
+	// Close enough to stop this period.
+	if (distance <= Q8(PANTILT_MAX_ACCEL) && axis->velocity <= Q8(PANTILT_MAX_ACCEL) &&
+			axis->velocity >= -Q8(PANTILT_MAX_ACCEL)) {
+		axis->position = axis->target;
+		axis->velocity = 0;
+		return (axis->position + 128) >> 8;
+	}
+
+	// Fastest speed towards the target (sqrt(2 * a * d), in 1/256 ticks).
+	desired = pantilt_isqrt(2 * PANTILT_MAX_ACCEL * distance) << 4;
+	if (desired > Q8(PANTILT_MAX_VELOCITY)) {
+		desired = Q8(PANTILT_MAX_VELOCITY);
+	}
+	if (desired > distance) {
+		desired = distance;
+	}
+	if (error < 0) {
+		desired = -desired;
+	}
+
+	// Accelerate towards that speed.
+	if (desired > axis->velocity + Q8(PANTILT_MAX_ACCEL)) {
+		axis->velocity += Q8(PANTILT_MAX_ACCEL);
+	} else if (desired < axis->velocity - Q8(PANTILT_MAX_ACCEL)) {
+		axis->velocity -= Q8(PANTILT_MAX_ACCEL);
+	} else {
+		axis->velocity = desired;
+	}
+
+	axis->position += axis->velocity;
+	return (axis->position + 128) >> 8;
+}
 
 /**
  * @brief Initialises the pan and tilt servos and set up GPIO and PWM.
@@ -45,16 +195,21 @@ void s4642286_reg_pantilt_init(void) {
     __TIM1_CLK_ENABLE();
 
     /* Compute the prescaler value
-	   Set the clock prescaler to 50kHz
+	   Set the clock prescaler to 1MHz (TIMER_COUNTING_FREQ)
 	   SystemCoreClock is the system clock frequency */
 	TIM1->PSC = ((SystemCoreClock / 2) / TIMER_COUNTING_FREQ) - 1;
 
 	// Set timer to count up.
 	TIM1->CR1 &= ~TIM_CR1_DIR; 
 
+	// Start both servos at 0 degrees, at rest.
+	pantiltAxes[0].position = pantiltAxes[0].target = Q8(pantilt_angle_to_ticks(0, 0));
+	pantiltAxes[1].position = pantiltAxes[1].target = Q8(pantilt_angle_to_ticks(1, 0));
+	pantiltAxes[0].velocity = pantiltAxes[1].velocity = 0;
+
 	TIM1->ARR = PWM_PULSE_WIDTH_TICKS; 								// Set PWM waveform period 
-	TIM1->CCR1 = PWM_PERCENT2TICKS_DUTYCYCLE(ZERO_DUTY_CYCLE);		// Set waveform duty cycle for Pan
-	TIM1->CCR2 = PWM_PERCENT2TICKS_DUTYCYCLE(ZERO_DUTY_CYCLE);		// Set waveform duty cycle for Tilt
+	TIM1->CCR1 = pantilt_angle_to_ticks(0, 0);						// Set waveform duty cycle for Pan
+	TIM1->CCR2 = pantilt_angle_to_ticks(1, 0);						// Set waveform duty cycle for Tilt
 
 	TIM1->CCMR1 &= ~(TIM_CCMR1_OC1M | TIM_CCMR1_OC2M); 	// Clear OC1M and OC2M (Channels 1 and 2) 
 	TIM1->CCMR1 |= ((0x06 << 4) | (0x06 << 12)); 		// Enable PWM Mode 1, upcounting, on Channels 1 and 2
@@ -69,27 +224,44 @@ void s4642286_reg_pantilt_init(void) {
 	   Set Off-State Selection for Idle mode (OSSI) bit */
 	TIM1->BDTR |= TIM_BDTR_MOE | TIM_BDTR_OSSR | TIM_BDTR_OSSI; 
 
+	// Update the trajectories on every update event (once per PWM period).
+	TIM1->DIER |= TIM_DIER_UIE;
+
+	// Enable priority (10) and interrupt callback. Do not set a priority lower than 5.
+	HAL_NVIC_SetPriority(TIM1_UP_TIM10_IRQn, 10, 0);
+	HAL_NVIC_EnableIRQ(TIM1_UP_TIM10_IRQn);
+
 	TIM1->CR1 |= TIM_CR1_CEN;	// Enable the counter
 }
 
 /**
- * @brief Writes an angle to pan or tilt servo.
+ * @brief Writes an angle to pan or tilt servo. The servo moves straight to the
+ * 		  angle, without a trajectory.
  * 
  * @param type Type is 0 for pan or 1 for tilt
  * @param angle the angle that will be written to either pan or tilt 
  */
 void s4642286_pantilt_angle_write(int type, int angle) {
-	// Convert angle to duty cycle.
-	double dutyCycle = ANGLE_TO_DUTYCYCLE(angle);
-	uint16_t numTicks = (uint16_t) PWM_PERCENT2TICKS_DUTYCYCLE(dutyCycle);
+	uint16_t numTicks;
+
+	if (type != 0 && type != 1) {
+		return;
+	}
+	numTicks = pantilt_angle_to_ticks(type, angle);
+
+	// Stop the trajectory at the new angle.
+	HAL_NVIC_DisableIRQ(TIM1_UP_TIM10_IRQn);
+	pantiltAxes[type].position = pantiltAxes[type].target = Q8(numTicks);
+	pantiltAxes[type].velocity = 0;
 
 	if (type == 0) {
 		// Adjust pan angle by changing CCR1 register value;.
 		TIM1->CCR1 = numTicks;
-	} else if (type == 1) {
+	} else {
 		// Adjust tilt angle by changing CCR2 register value.
 		TIM1->CCR2 = numTicks;
 	}
+	HAL_NVIC_EnableIRQ(TIM1_UP_TIM10_IRQn);
 }
 
 /**
@@ -98,13 +270,138 @@ void s4642286_pantilt_angle_write(int type, int angle) {
  * @param type Type is 0 for pan or 1 for tilt
  */
 int s4642286_pantilt_angle_read(int type) {
-	uint16_t tickNum;
-	
 	if (type == 0) {
-		tickNum = TIM1->CCR1;
+		return pantilt_ticks_to_angle(0, TIM1->CCR1);
 	} else if (type == 1) {
-		tickNum = TIM1->CCR2;
+		return pantilt_ticks_to_angle(1, TIM1->CCR2);
+	}
+	return 0;
+}
+
+/**
+ * @brief Sets the angle a servo moves to. The TIM1 update ISR moves the servo
+ * 		  there with limited velocity and acceleration.
+ * 
+ * @param type Type is 0 for pan or 1 for tilt
+ * @param angle the target angle (-90 to 90 degrees)
+ */
+void s4642286_pantilt_target_set(int type, int angle) {
+	if (type == 0 || type == 1) {
+		pantiltAxes[type].target = Q8(pantilt_angle_to_ticks(type, angle));
+	}
+}
+
+/**
+ * @brief Loads the calibration table of a servo.
+ * 
+ * @param type Type is 0 for pan or 1 for tilt
+ * @param ticks the measured ticks at -90, -45, 0, 45 and 90 degrees, or NULL
+ * 		  to load the nominal table
+ */
+void s4642286_pantilt_calibrate(int type, const int *ticks) {
+	static const int nominal[PANTILT_CAL_POINTS] = PANTILT_NOMINAL_CAL;
+	int i;
+
+	if (type != 0 && type != 1) {
+		return;
+	}
+	if (ticks == NULL) {
+		ticks = nominal;
+	}
+
+	for (i = 0; i < PANTILT_CAL_POINTS; i++) {
+		pantiltCal[type][i] = ticks[i];
+	}
+}
+
+/**
+ * @brief Interrupt handler (ISR) for TIM 1 Update IRQ Handler. Moves both
+ * 		  servos along their trajectories. CCR1 and CCR2 are preloaded, so the
+ * 		  new values take effect at the start of the next PWM period.
+ * 
+ */
+void TIM1_UP_TIM10_IRQHandler(void) {
+	if ((TIM1->SR & TIM_SR_UIF) == TIM_SR_UIF) {
+		// Clear the update interrupt flag.
+		TIM1->SR &= ~TIM_SR_UIF;
+
+		TIM1->CCR1 = pantilt_axis_update(&pantiltAxes[0]);
+		TIM1->CCR2 = pantilt_axis_update(&pantiltAxes[1]);
 	}
-	double dutyCycle = PWM_TICKS2PERCENT_DUTYCYCLE(tickNum);
-	return DUTYCYCLE_TO_ANGLE(dutyCycle);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Internal function to convert a filtered joystick value to a target
+ * 		  angle, and move the previous target towards it by at most
+ * 		  PANTILT_RATE_LIMIT degrees.
+ * 
+ * @param value the filtered joystick value (with the zero offset added)
+ * @param calOffset the 90 degree calibration offset of the servo
+ * @param target the previous target angle
+ * @return int the new target angle
+ */
+static int pantilt_track(int value, int calOffset, int target) {
+	int angle = ADC_TO_ANGLE(value);
+
+	// Hold the centre while the joystick is near it.
+	if (angle >= -PANTILT_DEADZONE && angle <= PANTILT_DEADZONE) {
+		angle = 0;
+	}
+	angle += calOffset;
+
+	if (angle > target + PANTILT_RATE_LIMIT) {
+		return target + PANTILT_RATE_LIMIT;
+	} else if (angle < target - PANTILT_RATE_LIMIT) {
+		return target - PANTILT_RATE_LIMIT;
+	}
+	return angle;
+}
+
+/**
+ * @brief The controlling task for the pan/tilt mount. Every
+ * 		  PANTILTTASK_PERIOD ticks it reads the DMA joystick averages, filters
+ * 		  them, applies the deadzone and rate limit, and sets the servo
+ * 		  targets. The TIM1 update ISR then writes CCR1 and CCR2.
+ * 		  -> The joystick ADC must already be initialised
+ * 		  (s4642286_reg_joystick_init()).
+ * 
+ */
+void s4642286TaskPanTilt(void) {
+	TickType_t lastWakeTime;
+	int filteredX, filteredY;
+	int panTarget = S4642286_REG_PANTILT_PAN_90_CAL_OFFSET;
+	int tiltTarget = S4642286_REG_PANTILT_TILT_90_CAL_OFFSET;
+
+	s4642286_reg_pantilt_init();
+
+	// Filtered values, scaled by 2^PANTILT_FILTER_SHIFT.
+	filteredX = (S4642286_REG_JOYSTICK_X_READ() + S4642286_REG_JOYSTICK_X_ZERO_CAL_OFFSET) << PANTILT_FILTER_SHIFT;
+	filteredY = (S4642286_REG_JOYSTICK_Y_READ() + S4642286_REG_JOYSTICK_Y_ZERO_CAL_OFFSET) << PANTILT_FILTER_SHIFT;
+
+	lastWakeTime = xTaskGetTickCount();
+
+	for (;;) {
+		// Smooth the values with a moving average (first order low pass filter).
+		filteredX += (S4642286_REG_JOYSTICK_X_READ() + S4642286_REG_JOYSTICK_X_ZERO_CAL_OFFSET) -
+			(filteredX >> PANTILT_FILTER_SHIFT);
+		filteredY += (S4642286_REG_JOYSTICK_Y_READ() + S4642286_REG_JOYSTICK_Y_ZERO_CAL_OFFSET) -
+			(filteredY >> PANTILT_FILTER_SHIFT);
+
+		panTarget = pantilt_track(filteredX >> PANTILT_FILTER_SHIFT, S4642286_REG_PANTILT_PAN_90_CAL_OFFSET, panTarget);
+		tiltTarget = pantilt_track(filteredY >> PANTILT_FILTER_SHIFT, S4642286_REG_PANTILT_TILT_90_CAL_OFFSET, tiltTarget);
+
+		S4642286_REG_PANTILT_PAN_TARGET(panTarget);
+		S4642286_REG_PANTILT_TILT_TARGET(tiltTarget);
+
+		// Run at a fixed rate (200Hz).
+		vTaskDelayUntil(&lastWakeTime, PANTILTTASK_PERIOD);
+	}
+}
+
+/**
+ * @brief Creates the pan/tilt controlling task.
+ * 
+ */
+void s4642286_tsk_pantilt_init(void) {
+	xTaskCreate( (void *) &s4642286TaskPanTilt, (const signed char *) "PANTILT", PANTILTTASK_STACK_SIZE, NULL, PANTILTTASK_PRIORITY, NULL);
+}
@@ -8,6 +8,11 @@
  * EXTERNAL FUNCTIONS 
  ***************************************************************
  * s4642286_reg_pantilt_init() - Initialise servos, GPIO pins and PWM.
+ * s4642286_pantilt_angle_write() - Move a servo straight to an angle.
+ * s4642286_pantilt_angle_read() - Read the current angle of a servo.
+ * s4642286_pantilt_target_set() - Set the angle a servo moves smoothly to.
+ * s4642286_pantilt_calibrate() - Load the calibration table of a servo.
+ * s4642286_tsk_pantilt_init() - Create the pan/tilt joystick tracking task.
  *************************************************************** 
  */
 
@@ -18,17 +23,47 @@
 extern void s4642286_reg_pantilt_init(void);
 void s4642286_pantilt_angle_write(int type, int angle);
 int s4642286_pantilt_angle_read(int type);
+void s4642286_pantilt_target_set(int type, int angle);
+void s4642286_pantilt_calibrate(int type, const int *ticks);
+extern void s4642286_tsk_pantilt_init(void);
+
+// Task Priority
+#define PANTILTTASK_PRIORITY	( tskIDLE_PRIORITY + 3 )
+
+// Task Stack Size
+#define PANTILTTASK_STACK_SIZE ( configMINIMAL_STACK_SIZE * 2 )
+
+// Tracking task period in ticks (5ms, 200Hz).
+#define PANTILTTASK_PERIOD 5
+
+// Joystick tracking: filter strength (weight 1/2^shift), centre deadzone and
+// the largest target change per task period (degrees).
+#define PANTILT_FILTER_SHIFT 3
+#define PANTILT_DEADZONE 2
+#define PANTILT_RATE_LIMIT 1
 
 // Macro Function Definitions
 #define S4642286_REG_PANTILT_PAN_WRITE(angle) s4642286_pantilt_angle_write(0, angle)
 #define S4642286_REG_PANTILT_PAN_READ() s4642286_pantilt_angle_read(0)
 #define S4642286_REG_PANTILT_TILT_WRITE(angle) s4642286_pantilt_angle_write(1, angle)
 #define S4642286_REG_PANTILT_TILT_READ() s4642286_pantilt_angle_read(1)
+#define S4642286_REG_PANTILT_PAN_TARGET(angle) s4642286_pantilt_target_set(0, angle)
+#define S4642286_REG_PANTILT_TILT_TARGET(angle) s4642286_pantilt_target_set(1, angle)
+
+// Angle range, and the calibration table (ticks at every PANTILT_CAL_STEP degrees).
+#define PANTILT_ANGLE_MIN -90
+#define PANTILT_ANGLE_MAX 90
+#define PANTILT_CAL_STEP 45
+#define PANTILT_CAL_POINTS 5
+
+// Trajectory limits, in ticks per PWM period.
+#define PANTILT_MAX_VELOCITY 120    // About 5 degrees per period
+#define PANTILT_MAX_ACCEL 8
 
 // Define Configuration Parameters
 #define S4642286_REG_PANTILT_PAN_90_CAL_OFFSET 20
 #define S4642286_REG_PANTILT_TILT_90_CAL_OFFSET 10
 
-#define ADC_TO_ANGLE(adcValue) (int)floor((45.0/1024.0) * (double)adcValue - 90.0)
+#define ADC_TO_ANGLE(adcValue) ((int)((45 * (adcValue)) >> 10) - 90)
 
 #endif
\ No newline at end of file
@@ -22,7 +22,9 @@ CFLAGS += -I$(MYLIB_PATH)
 # DO NOT USE absolute file paths (e.g. /home/users/myuser/mydir)
 LIBSRCS += $(MYLIB_PATH)/s4642286_oled.c $(MYLIB_PATH)/s4642286_joystick.c $(MYLIB_PATH)/s4642286_CAG_joystick.c $(MYLIB_PATH)/s4642286_lta1000g.c 
 
-LIBSRCS += $(MYLIB_PATH)/s4642286_CAG_simulator.c $(MYLIB_PATH)/s4642286_CAG_display.c $(MYLIB_PATH)/s4642286_CAG_grid.c $(MYLIB_PATH)/s4642286_CAG_mnemonic.c $(MYLIB_PATH)/s4642286_cli_CAG_mnemonic.c
+LIBSRCS += $(MYLIB_PATH)/s4642286_CAG_simulator.c $(MYLIB_PATH)/s4642286_CAG_engine.c $(MYLIB_PATH)/s4642286_CAG_display.c $(MYLIB_PATH)/s4642286_CAG_grid.c $(MYLIB_PATH)/s4642286_CAG_mnemonic.c $(MYLIB_PATH)/s4642286_cli_CAG_mnemonic.c
+
+LIBSRCS += $(MYLIB_PATH)/s4642286_hamming.c $(MYLIB_PATH)/s4642286_hamming_pipeline.c
 
 SSD1306_PATH=$(SOURCELIB_ROOT)/components/peripherals/ssd1306/nucleo-f429
 
@@ -22,6 +22,7 @@
 #include "s4642286_CAG_joystick.h"
 #include "s4642286_joystick.h"
 #include "s4642286_lta1000g.h"
+#include "s4642286_hamming_pipeline.h"
 
 /*
  * Starts all the other tasks, then starts the scheduler.
@@ -41,6 +42,9 @@ int main( void ) {
 	s4642286_tsk_CAGJoystick_init();
 	s4642286_tsk_joystick_init();
 
+	// Decode Hamming encoded bytes from USART6 (statistics with the hamstat command).
+	s4642286_tsk_hamming_pipeline_init(HAMMING_PIPELINE_DECODE);
+
 	/* Start the scheduler.*/
 	vTaskStartScheduler();
 
@@ -0,0 +1,95 @@
+# Worst case stack of each task entry function, from the .ci call graph files
+# written by gcc -fcallgraph-info=su (one file per object). Task entry
+# functions are the functions matching the pattern that nothing calls.
+#
+# The worst case of a function is its own frame plus the worst case of the
+# deepest function it calls. Calls that cannot be sized are listed after the
+# total, which is then a lower bound:
+#   indirect  - a call through a function pointer
+#   recursive - a call back into a function already on the path
+#   <name>    - a function with no frame size (e.g. libc, or not compiled
+#               with -fcallgraph-info)
+#
+# Usage: awk -f stackusage.awk [pattern=Task] *.ci
+
+BEGIN {
+	if (pattern == "") {
+		pattern = "Task"
+	}
+}
+
+# node: { title: "b.c:helper" label: "helper\nb.c:1:12\n408 bytes (static)" }
+/^node:/ {
+	title = field($0, "title")
+	label = field($0, "label")
+	name[title] = label
+	sub(/\\n.*/, "", name[title])
+	if (label ~ /[0-9]+ bytes/) {
+		size = label
+		sub(/ bytes.*/, "", size)
+		sub(/.*\\n/, "", size)
+		frame[title] = size + 0
+	}
+}
+
+# edge: { sourcename: "TaskA" targetname: "leaf" label: "a.c:5:53" }
+/^edge:/ {
+	calls[field($0, "sourcename")] = calls[field($0, "sourcename")] " " field($0, "targetname")
+	called[field($0, "targetname")] = 1
+}
+
+END {
+	for (f in frame) {
+		# Task entry functions are only passed to xTaskCreate, never called.
+		if (name[f] ~ pattern && !(f in called)) {
+			unsized = ""
+			total = worst(f)
+			printf "%8d  %s%s\n", total, name[f], (unsized != "") ? "  (+" unsized ")" : ""
+		}
+	}
+}
+
+# Returns the value of a quoted field of a node or edge line.
+function field(line, key,    start) {
+	start = index(line, key ": \"")
+	if (start == 0) {
+		return ""
+	}
+	line = substr(line, start + length(key) + 3)
+	return substr(line, 1, index(line, "\"") - 1)
+}
+
+# Adds a call that cannot be sized to the list for the current task.
+function note(what) {
+	if (index(unsized " ", " " what " ") == 0) {
+		unsized = unsized " " what
+	}
+}
+
+# Worst case stack of a function, following its calls depth first.
+function worst(f,    n, i, callees, deepest, depth) {
+	if (f == "__indirect_call") {
+		note("indirect")
+		return 0
+	}
+	if (!(f in frame)) {
+		note(name[f] != "" ? name[f] : f)
+		return 0
+	}
+	if (onPath[f]) {
+		note("recursive")
+		return 0
+	}
+
+	onPath[f] = 1
+	deepest = 0
+	n = split(calls[f], callees, " ")
+	for (i = 1; i <= n; i++) {
+		depth = worst(callees[i])
+		if (depth > deepest) {
+			deepest = depth
+		}
+	}
+	onPath[f] = 0
+	return frame[f] + deepest
+}
@@ -2,6 +2,9 @@
 # LIBRARY SOURCES - MUST BE IN THE SAME FOLDER as main.c (DO NOT CHANGE)
 ########################################################################
 
+# Including memory heap model
+LIBSRCS += $(FREERTOS_PATH)/portable/MemMang/heap_1.c
+
 # Set mylib folder path.
 # Do not change the MYLIB_PATH variable name.
 # ONLY use relative file paths that start with $(SOURCELIB_ROOT)../
@@ -5,39 +5,54 @@
   * @date    15032022
   * @brief   This program will allow the pan and tilt servomotors to be
   *          controlled using the joystick, and the current pan angle will be
-  *          displayed on the LTA1000G LED Board.
+  *          displayed on the LTA1000G LED Board. The servos are driven by the
+  *          pan/tilt FreeRTOS task, which tracks the joystick at 200Hz.
   ******************************************************************************
   */
 
 #include "board.h"
 #include "processor_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
 #include "s4642286_joystick.h"
 #include "s4642286_lta1000g.h"
 #include "s4642286_pantilt.h"
-#include "math.h"
+
+// Task Priority
+#define LEDBARTASK_PRIORITY ( tskIDLE_PRIORITY + 2 )
+
+// Task Stack Size
+#define LEDBARTASK_STACK_SIZE ( configMINIMAL_STACK_SIZE * 2 )
 
 // Function Definitions
 void hardware_init(void);
+void TaskLEDBar(void);
 
 /**
- * @brief This function contains the main loop for the program.
- * 
+ * @brief Starts the pan/tilt and LED Bar tasks, then starts the scheduler.
+ *
  */
-void main(void) {
+int main(void) {
   // Set up system hardware.
   HAL_Init();
   hardware_init();
 
-  // Main Processing Loop
-  while (1) {
-    // Read the joystick's x and y analog inputs and convert them to angles.
-    int panAngle = ADC_TO_ANGLE(S4642286_REG_JOYSTICK_X_READ() + S4642286_REG_JOYSTICK_X_ZERO_CAL_OFFSET);
-    int tiltAngle = ADC_TO_ANGLE(S4642286_REG_JOYSTICK_Y_READ() + S4642286_REG_JOYSTICK_Y_ZERO_CAL_OFFSET);
+  // Create the tasks.
+  s4642286_tsk_pantilt_init();
+  xTaskCreate( (void *) &TaskLEDBar, (const signed char *) "LEDBAR", LEDBARTASK_STACK_SIZE, NULL, LEDBARTASK_PRIORITY, NULL );
 
-    // Write angles to pan and tilt module.
-    S4642286_REG_PANTILT_PAN_WRITE(panAngle + S4642286_REG_PANTILT_PAN_90_CAL_OFFSET);
-    S4642286_REG_PANTILT_TILT_WRITE(tiltAngle + S4642286_REG_PANTILT_TILT_90_CAL_OFFSET);
+  /* Start the scheduler.*/
+  vTaskStartScheduler();
+
+  return 0;
+}
 
+/**
+ * @brief A task which shows the current pan angle on the LED Bar.
+ *
+ */
+void TaskLEDBar(void) {
+  for (;;) {
     // Update LED Bar with current Pan Angle.
     int currentPanAngle = S4642286_REG_PANTILT_PAN_READ() + 90; // Shift by 90 degrees (90->180, 0->90, -90->0)
     int segment = currentPanAngle / 20;
@@ -49,16 +64,16 @@ void main(void) {
       s4642286_reg_lta1000g_write(0);
     }
 
-    HAL_Delay(50);
+    vTaskDelay(50);
   }
 }
 
 /**
- * @brief Initialise the LED Bar, Joystick and Pantilt Module.
- * 
+ * @brief Initialise the LED Bar and Joystick. The pan/tilt task initialises
+ *        the Pantilt Module.
+ *
  */
 void hardware_init(void) {
   s4642286_reg_lta1000g_init();
-  s4642286_reg_joystick_init(); 
-  s4642286_reg_pantilt_init();
-}
\ No newline at end of file
+  s4642286_reg_joystick_init();
+}
@@ -26,6 +26,41 @@ void hardware_init(void);
 #define S2 2    // DECODE
 #define S3 3    // REMOTE RECEIVE
 
+// Define Event Types
+#define EVENT_UART 0        // A character was received on the console
+#define EVENT_IR 1          // A key was received from the IR remote
+#define EVENT_JOYSTICK 2    // The joystick pushbutton was pressed
+
+// Size of the event queue (must be a power of 2).
+#define EVENT_QUEUE_SIZE 32
+
+/**
+ * @brief A struct for an input event.
+ * 
+ */
+typedef struct {
+    uint8_t type;   // EVENT_UART, EVENT_IR or EVENT_JOYSTICK
+    char value;     // Received character or key
+    uint8_t resync; // 1 if an earlier event of this type was dropped
+} event_t;
+
+// Event queue, written by the UART ISR and the main loop (with interrupts disabled).
+static event_t eventQueue[EVENT_QUEUE_SIZE];
+static volatile uint32_t eventHead = 0, eventTail = 0;
+
+// Number of events dropped because the queue was full, and the types
+// (bit n for type n) whose next event must restart its character pair.
+static volatile uint32_t eventsDropped = 0;
+static volatile uint8_t eventResync = 0;
+
+// FSM state and inputs.
+static int currentState = S0;   // Begin in IDLE state
+static int inputCount = 0, numInputIR = 0;
+static char lastRecvChar, recvCharIR1;
+
+// Encoded bytes shown on the LED bar in the encoding state.
+static uint8_t firstByte, secondByte;
+static int displayedByte = 0;
 
 /**
  * @brief Converts a character into an integer if it is a valid Hex numbers.
@@ -65,254 +100,272 @@ int convert(char input) {
 }
 
 /**
- * @brief The main program.
+ * @brief Adds an event to the event queue. Events are dropped (and counted)
+ *        if the queue is full. Must be called from an ISR or with interrupts
+ *        disabled.
+ *        -> The next event of a dropped type is marked, so the main loop
+ *        starts a new character pair there instead of pairing across the gap.
  * 
+ * @param type the event type.
+ * @param value the received character or key.
  */
-void main(void) {
-    // Initialise variables for cyclic executive
-    uint32_t lastTick = 0;
+static void event_post(uint8_t type, char value) {
+    if ((eventHead - eventTail) >= EVENT_QUEUE_SIZE) {
+        eventsDropped++;
+        eventResync |= (0x01 << type);
+        return;
+    }
+
+    eventQueue[eventHead & (EVENT_QUEUE_SIZE - 1)].type = type;
+    eventQueue[eventHead & (EVENT_QUEUE_SIZE - 1)].value = value;
+    eventQueue[eventHead & (EVENT_QUEUE_SIZE - 1)].resync = (eventResync >> type) & 0x01;
+    eventResync &= ~(0x01 << type);
+    eventHead++;
+}
+
+/**
+ * @brief Removes the oldest event from the event queue. Must be called with
+ *        interrupts disabled.
+ * 
+ * @param event a pointer to store the event in.
+ * @return int 1 if an event was removed, or 0 if the queue is empty.
+ */
+static int event_get(event_t *event) {
+    if (eventHead == eventTail) {
+        return 0;
+    }
+    *event = eventQueue[eventTail & (EVENT_QUEUE_SIZE - 1)];
+    eventTail++;
+    return 1;
+}
+
+/**
+ * @brief Handles a mode command (EE, DD or FF) in any state.
+ * 
+ * @param recvChar1 the first character of the command.
+ * @param recvChar2 the second character of the command.
+ * @return int 1 if the characters were a mode command, else 0.
+ */
+static int process_mode(char recvChar1, char recvChar2) {
+    int newState;
+
+    if (recvChar1 == 'E' && recvChar2 == 'E') {
+        newState = S1;  // Encoding State
+    } else if (recvChar1 == 'D' && recvChar2 == 'D') {
+        newState = S2;  // Decoding State
+    } else if (recvChar1 == 'F' && recvChar2 == 'F' && currentState != S0) {
+        newState = S0;  // IDLE State
+    } else {
+        return 0;
+    }
+
+    // Clear the LED bar when changing state.
+    if (newState != currentState) {
+        s4642286_reg_lta1000g_write(0);
+    }
+    currentState = newState;
+    numInputIR = 0;
+    return 1;
+}
+
+/**
+ * @brief Handles a pair of characters received on the console.
+ * 
+ * @param recvChar1 the first character received.
+ * @param recvChar2 the second character received.
+ */
+static void process_uart_pair(char recvChar1, char recvChar2) {
+    int number1, number2;
+    unsigned short encodedByte, displayValue;
+    hammingResult_t decodeResult;
+
+    if (process_mode(recvChar1, recvChar2) || (number1 = convert(recvChar1)) == -1 ||
+            (number2 = convert(recvChar2)) == -1) {
+        return;
+    }
+
+    switch (currentState) {
+        case S1:    // Encoding State
+            // Combine characters into one byte and encode.
+            encodedByte = s4642286_lib_hamming_byte_encode(((number1 << 4) | number2));
+            
+            // Split bytes
+            firstByte = (encodedByte >> 8);
+            secondByte = (encodedByte & 0xFF);
+
+            s4642286_reg_lta1000g_write(firstByte);
+            displayedByte = 1;
+            break;
+
+        case S2:    // Decoding State
+            decodeResult = s4642286_lib_hamming_secded_decode((number1 << 4) | number2);
+            displayValue = decodeResult.data;
+
+            if (decodeResult.status == HAMMING_DOUBLE_ERROR) {
+                // A 2 bit error was detected and could not be corrected
+                displayValue |= (0x02 << 8);
+
+            } else if (decodeResult.status != HAMMING_CLEAN) {
+                // A 1 bit error was corrected
+                displayValue |= (0x01 << 8);
+            }
+            s4642286_reg_lta1000g_write(displayValue);
+            break;
+
+        case S3:    // Remote Receive State
+            // Console input restarts the IR key pair.
+            numInputIR = 0;
+            break;
+
+        default:
+            break;
+    }
+}
 
-    // Initialise variables for FSM inputs and states
-    char recvChar1, recvChar2;
-    int currentState = S0; // Begin in IDLE state
-    int inputCount = 0, numInputIR = 0, number1, number2;
+/**
+ * @brief Handles a key received from the IR remote. A key in any other state
+ *        moves to the remote receive state and is used as the first key.
+ * 
+ * @param key the key received.
+ */
+static void process_ir_key(char key) {
+    uint8_t dataBits, hammingBits, errorBits = 0x00;
+    hammingResult_t decodeResult;
+
+    if (currentState != S3) {
+        // Move to remote receive state
+        s4642286_reg_lta1000g_write(0);
+        currentState = S3;
+        numInputIR = 0;
+    }
+
+    if (numInputIR == 0) {
+        recvCharIR1 = key;
+        numInputIR++;
+        return;
+    }
+
+    decodeResult = s4642286_lib_hamming_secded_decode(((recvCharIR1 - 48) << 4) | (key - 48));
+
+    // Extract Data and Hamming bits
+    dataBits = decodeResult.data;
+    hammingBits = (decodeResult.codeword & 0x0E);
+
+    if (decodeResult.status == HAMMING_DOUBLE_ERROR) {
+        // A 2 bit error was detected and could not be corrected
+        errorBits = 0x02;
+
+    } else if (decodeResult.status != HAMMING_CLEAN) {
+        // A 1 bit error was corrected
+        errorBits = 0x01;
+    }
+
+    debug_log("%X, %X, %X\r\n", dataBits, hammingBits, errorBits);
+    numInputIR = 0;
+    inputCount = 0;
+}
+
+/**
+ * @brief Handles a joystick press, which swaps the encoded byte shown on the
+ *        LED bar in the encoding state.
+ * 
+ */
+static void process_joystick(void) {
+    if (currentState != S1 || displayedByte == 0) {
+        return;
+    }
+
+    if (displayedByte == 1) {
+        s4642286_reg_lta1000g_write(secondByte);
+        displayedByte = 2;
+
+    } else {
+        s4642286_reg_lta1000g_write(firstByte);
+        displayedByte = 1;
+    }
+}
+
+/**
+ * @brief The main program. Inputs are handled as events as soon as they
+ *        arrive, and the core sleeps (WFI) while there is nothing to do.
+ *        SysTick is left running for HAL_GetTick() (pushbutton debouncing),
+ *        so the core also wakes briefly every 1ms.
+ * 
+ */
+void main(void) {
     int lastJoystickPressCount = 0;
-    unsigned short decodedValue, displayValue;
+    event_t event;
 
     HAL_Init();			//Initialise board.
     hardware_init();	//Initialise hardware modules
 
-    // Main cyclic executive
+#ifdef S4642286_HAMMING_SELFTEST
+    // Verify the Hamming codec before using it (the host tests in test/ run it too).
+    if (s4642286_lib_hamming_selftest() != 0) {
+        debug_log("Hamming self test failed\r\n");
+    }
+#endif
+
+    // Main event loop
     while(1) {
-        // Process inputs every 100ms.
-        if ((HAL_GetTick() - lastTick) >= 150) { 
-            switch (currentState) {
-                case S0: ;  // IDLE STATE
-                    // Check if a key has been pressed on IR Remote
-                    if (keyPressedFlag) {
-                        // Move to remote receive state
-                        s4642286_reg_lta1000g_write(0);
-                        currentState = S3;
-                        break;
-                    }
-                    // Read for two key presses (apart from null character)
-                    if (inputCount == 0 && (recvChar1 = BRD_debuguart_getc()) != '\0') {
-                        inputCount += 1;
-                    }
-                    if (inputCount == 1 && (recvChar2 = BRD_debuguart_getc()) != '\0') {
-                        inputCount += 1;
-                    }
-                    
-                    // Check if input is valid and move to new state if valid.
-                    if (inputCount == 2) {
-                        if (recvChar1 == 'E' && recvChar2 == 'E') {
-                            // Move to Encoding State
-                            currentState = S1;
-
-                        } else if (recvChar1 == 'D' && recvChar2 == 'D') {
-                            // Move to Decoding State
-                            currentState = S2;
-                            
-                        } else {
-                            // Remain in IDLE state
-                            currentState = S0;
-                        }
-                        inputCount = 0;
-                    }
-                    break;
-
-                case S1: ;  //Encoding State         
-                    if (keyPressedFlag) {
-                        // Move to remote receive state
-                        s4642286_reg_lta1000g_write(0);
-                        currentState = S3;
-                        break;
-                    }
-
-                    unsigned short encodedByte;
-                    uint8_t firstByte, secondByte;
-                    int displayedByte;
-                    // Read for two key presses (apart from null character)
-                    if (inputCount == 0 && (recvChar1 = BRD_debuguart_getc()) != '\0') {
-                        inputCount += 1;
-                    }
-                    if (inputCount == 1 && (recvChar2 = BRD_debuguart_getc()) != '\0') {
-                        inputCount += 1;
-                    }
-                    
-                    if (inputCount == 2) {
-                        if (recvChar1 == 'F' && recvChar2 == 'F') {
-                            // Move to IDLE State
-                            s4642286_reg_lta1000g_write(0);
-                            currentState = S0;
-
-                        } else if (recvChar1 == 'D' && recvChar2 == 'D') {
-                            // Move to Decoding State
-                            s4642286_reg_lta1000g_write(0);
-                            currentState = S2;
-
-                        } else if (recvChar1 == 'E' && recvChar2 == 'E') {
-                            // Remain in Encoding State
-                            currentState = S1;
-
-                        } else if ((number1 = convert(recvChar1)) != -1 &&
-                                (number2 = convert(recvChar2)) != -1) {
-
-                            // Combine characters into one byte and encode.
-                            encodedByte = s4642286_lib_hamming_byte_encode(((number1 << 4) | number2));
-                            
-                            // Split bytes
-                            firstByte = (encodedByte >> 8);
-                            secondByte = (encodedByte & 0xFF);
-
-                            s4642286_reg_lta1000g_write(firstByte);
-                            displayedByte = 1;
-                        } 
-                        inputCount = 0;
-                    }
-
-                    // Display Encoded Bytes on LED Bar.
-                    if (s4642286_reg_joystick_press_get() > lastJoystickPressCount) {
-                        if (displayedByte == 1) {
-                            s4642286_reg_lta1000g_write(secondByte);
-                            displayedByte = 2;
-
-                        } else {
-                            s4642286_reg_lta1000g_write(firstByte);
-                            displayedByte = 1;
-
-                        }
-                        // Update last joystick press count.
-                        lastJoystickPressCount = s4642286_reg_joystick_press_get();
-                    }
-                    break;
-
-                case S2: ;  // Decoding State
-                    if (keyPressedFlag) {
-                        // Move to remote receive state
-                        s4642286_reg_lta1000g_write(0);
-                        currentState = S3;
-                        break;
-                    }
-
-                    // Read for two key presses (apart from null character)
-                    if (inputCount == 0 && (recvChar1 = BRD_debuguart_getc()) != '\0') {
-                        inputCount += 1;
-                    }
-                    if (inputCount == 1 && (recvChar2 = BRD_debuguart_getc()) != '\0') {
-                        inputCount += 1;
-                    }
-                    
-                    if (inputCount == 2) {
-                        if (recvChar1 == 'F' && recvChar2 == 'F') {
-                            // Move to IDLE State
-                            s4642286_reg_lta1000g_write(0);
-                            currentState = S0;
-
-                        } else if (recvChar1 == 'E' && recvChar2 == 'E') {
-                            // Move to Encoding State
-                            s4642286_reg_lta1000g_write(0);
-                            currentState = S1;
-
-                        } else if (recvChar1 == 'D' && recvChar2 == 'D') {
-                            // Remain in Decoding State
-                            currentState = S2;
-
-                        } else if ((number1 = convert(recvChar1)) != -1 &&
-                                (number2 = convert(recvChar2)) != -1) {
-
-                            uint8_t value = ((number1 << 4) | number2);
-
-                            // Decode value
-                            decodedValue = s4642286_lib_hamming_byte_decode(value);
-                            displayValue = (decodedValue >> 4);
-
-                            if (s4642286_lib_hamming_parity_error(value)) {
-                                // A parity check error occurred
-                                displayValue |= (0x02 << 8);
-
-                            } else if (value != decodedValue) {
-                                // A bit error must have occurred, since the bytes before and
-                                // after error correction are different.
-                                displayValue |= (0x01 << 8);
-                            }
-                            s4642286_reg_lta1000g_write(displayValue);
-                        }
-                        inputCount = 0;
-                    }
-                    break;
-
-                case S3: ; // REMOTE RECEIVE STATE
-                    char recvCharIR1, recvCharIR2;
-                    uint8_t dataBits, hammingBits, errorBits = 0x00;
-
-                    if (numInputIR == 0 && s4642286_irremote_readkey(&keyPressedValue)) {
-                        recvCharIR1 = keyPressedValue;
-                        numInputIR++;
-                    }
-                    if (numInputIR == 1 && s4642286_irremote_readkey(&keyPressedValue)) {
-                        recvCharIR2 = keyPressedValue;
-                        numInputIR++;
-                    }
-
-                    if (numInputIR == 2) {
-                        uint8_t value = ((recvCharIR1 - 48) << 4) | ((recvCharIR2 - 48));
-                        decodedValue = s4642286_lib_hamming_byte_decode(value);
-
-                        // Extract Data and Hamming bits
-                        dataBits =  (decodedValue >> 4);
-                        hammingBits = (decodedValue & 0x0E);
-
-                        if (s4642286_lib_hamming_parity_error(value)) {
-                            // A parity check error occurred
-                            errorBits = 0x02;
-
-                        } else if (value != decodedValue) {
-                            // A bit error must have occurred, since the bytes before and
-                            // after error correction are different.
-                            errorBits = 0x01;
-                        }
-
-                        debug_log("%X, %X, %X\r\n", dataBits, hammingBits, errorBits);
-                        numInputIR = 0;
-                        inputCount = 0;
-                    }
-
-                    /** STATE TRANSITION LOGIC **/
-
-                    // Read for two key presses (apart from null character)
-                    if (inputCount == 0 && (recvChar1 = BRD_debuguart_getc()) != '\0') {
-                        inputCount += 1;
-                    }
-                    if (inputCount == 1 && (recvChar2 = BRD_debuguart_getc()) != '\0') {
-                        inputCount += 1;
-                    }
-                    
-                    if (inputCount == 2) {
-                        if (recvChar1 == 'F' && recvChar2 == 'F') {
-                            // Move to IDLE State
-                            s4642286_reg_lta1000g_write(0);
-                            currentState = S0;
-
-                        } else if (recvChar1 == 'E' && recvChar2 == 'E') {
-                            // Move to Encoding State
-                            s4642286_reg_lta1000g_write(0);
-                            currentState = S1;
-
-                        } else if (recvChar1 == 'D' && recvChar2 == 'D') {
-                            // Move to Decoding State
-                            s4642286_reg_lta1000g_write(0);
-                            currentState = S2;
-                        }
-                        inputCount = 0;
-                        numInputIR = 0;
-                    }
-                    break;
-        
-                default:
-                    break;
+        // Interrupts are disabled from the checks until WFI, so an interrupt
+        // in between still wakes the core (it is handled after __enable_irq).
+        __disable_irq();
+
+#ifdef S4642286_IRREMOTE_DMA
+        // Decode the IR edges captured since the last wake (SysTick wakes the core every 1ms).
+        s4642286_irremote_capture_process();
+#endif
+
+        // Turn queued IR frames and new joystick presses into events.
+        while (s4642286_irremote_readkey(&keyPressedValue)) {
+            event_post(EVENT_IR, keyPressedValue);
+        }
+        if (s4642286_reg_joystick_press_get() != lastJoystickPressCount) {
+            lastJoystickPressCount = s4642286_reg_joystick_press_get();
+            event_post(EVENT_JOYSTICK, 0);
+        }
+
+        if (!event_get(&event)) {
+            // Sleep until the next interrupt.
+            __WFI();
+            __enable_irq();
+            continue;
+        }
+        __enable_irq();
+
+        if (event.resync) {
+            // Events of this type were lost before it, so do not pair across them.
+            debug_log("%lu events dropped\r\n", (unsigned long) eventsDropped);
+            if (event.type == EVENT_UART) {
+                inputCount = 0;
+            } else if (event.type == EVENT_IR) {
+                numInputIR = 0;
             }
-            lastTick =  HAL_GetTick();
+        }
+
+        switch (event.type) {
+            case EVENT_UART:
+                // Commands and values are pairs of characters.
+                if (inputCount == 0) {
+                    lastRecvChar = event.value;
+                    inputCount = 1;
+                } else {
+                    process_uart_pair(lastRecvChar, event.value);
+                    inputCount = 0;
+                }
+                break;
+
+            case EVENT_IR:
+                process_ir_key(event.value);
+                break;
+
+            case EVENT_JOYSTICK:
+                process_joystick();
+                break;
+
+            default:
+                break;
         }
     }
     return;
@@ -328,4 +381,29 @@ void hardware_init(void) {
     s4642286_reg_joystick_pb_init();
     s4642286_irremote_init();
     BRD_debuguart_init(); 
-}
\ No newline at end of file
+
+    // Enable the console (USART3) receive interrupt.
+    USART3->CR1 |= USART_CR1_RXNEIE;
+
+    // Enable priority (10) and interrupt callback. Do not set a priority lower than 5.
+    HAL_NVIC_SetPriority(USART3_IRQn, 10, 0);
+    HAL_NVIC_EnableIRQ(USART3_IRQn);
+}
+
+/**
+ * @brief Interrupt handler (ISR) for USART3 (console). Posts each received
+ *        character (apart from the null character) to the event queue.
+ * 
+ */
+void USART3_IRQHandler(void) {
+    char recvChar;
+
+    // Reading DR clears the receive and overrun flags.
+    if ((USART3->SR & (USART_SR_RXNE | USART_SR_ORE)) != 0) {
+        recvChar = USART3->DR;
+
+        if (recvChar != '\0') {
+            event_post(EVENT_UART, recvChar);
+        }
+    }
+}
@@ -0,0 +1,324 @@
+ /**
+ **************************************************************
+ * @file test/bench_cli_CAG_mnemonic.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host replay benchmark for the CAG Mnemonic CLI command path
+ ***************************************************************
+ * Usage:
+ *   bench_cli_CAG_mnemonic [commands]  - replay generated commands (default 10000)
+ *   bench_cli_CAG_mnemonic -f FILE     - replay the command lines in FILE
+ *   bench_cli_CAG_mnemonic -p N        - print N generated commands, for
+ *                                        cli_replay.py on the target
+ *
+ * Each command line takes the path of s4642286TaskCAGMnemonic: the
+ * FreeRTOS_CLIProcessCommand loop, then the output loop that runs inside
+ * portENTER_CRITICAL. The simulator side then takes the message off SimQueue
+ * and draws it with the CAG engine, which is the board update. Reported:
+ *   - commands/s through the whole path,
+ *   - latency from the end of the command line to the board update,
+ *   - the longest output loop (the interrupt-disabled time on the target),
+ *   - the latency the task delays add on the target, which the host does not
+ *     sleep for: one character per MNEMONIC_POLL_MS pass, MNEMONIC_CHUNK_MS
+ *     after each output chunk and up to SIMULATOR_POLL_MS in the simulator.
+ * Host maximums include any preemption by the host scheduler.
+ ***************************************************************
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// The command path runs the CLI module's registered handlers.
+#include "../mylib/s4642286_cli_CAG_mnemonic.c"
+
+// Default number of generated commands.
+#define BENCH_COMMANDS 10000
+
+// Longest command line the CLI task accepts (InputIndex < 20).
+#define BENCH_MAX_INPUT 20
+
+// Task delays on the target (s4642286_CAG_mnemonic.c and s4642286_CAG_simulator.c).
+#define MNEMONIC_POLL_MS 50
+#define MNEMONIC_CHUNK_MS 5
+#define SIMULATOR_POLL_MS 10
+
+// SimQueue length (s4642286_CAG_simulator.c).
+#define SIM_QUEUE_LENGTH 5
+
+uint32_t SystemCoreClock = 180000000;
+
+// Board drawn on by the simulator side.
+static int board[SIMULATION_WIDTH][SIMULATION_HEIGHT];
+
+// SimQueue: a FIFO of messages, emptied after each command.
+static caMessage_t simQueue[SIM_QUEUE_LENGTH];
+static int simQueueCount;
+
+// Event bits set by start, stop and clear.
+static EventBits_t simBits;
+
+// Console output, counted instead of sent.
+static volatile unsigned long outputChars;
+
+static unsigned long messages, rejected;
+
+/*
+ * FreeRTOS stand-ins for the command handlers.
+ */
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void *item, TickType_t wait) {
+
+	(void) queue;
+	(void) wait;
+
+	if (simQueueCount == SIM_QUEUE_LENGTH) {
+		return pdFAIL;
+	}
+	memmove(&simQueue[1], &simQueue[0], simQueueCount * sizeof(caMessage_t));
+	simQueue[0] = *(const caMessage_t *) item;
+	simQueueCount++;
+	return pdPASS;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t wait) {
+
+	(void) queue;
+	(void) wait;
+
+	if (simQueueCount == SIM_QUEUE_LENGTH) {
+		return pdFAIL;
+	}
+	simQueue[simQueueCount++] = *(const caMessage_t *) item;
+	return pdPASS;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits) {
+	(void) group;
+	simBits |= bits;
+	return simBits;
+}
+
+TickType_t xTaskGetTickCount(void) { return 0; }
+void vTaskDelete(TaskHandle_t task) { (void) task; }
+eTaskState eTaskGetState(TaskHandle_t task) { (void) task; return eRunning; }
+void vTaskList(char *buffer) { buffer[0] = '\0'; }
+UBaseType_t uxTaskGetNumberOfTasks(void) { return 0; }
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, UBaseType_t size, uint32_t *runTime) {
+	(void) status;
+	(void) runTime;
+	return size;
+}
+void *pvPortMalloc(size_t size) { return malloc(size); }
+void vPortFree(void *pointer) { free(pointer); }
+size_t xPortGetFreeHeapSize(void) { return 0; }
+size_t xPortGetMinimumEverFreeHeapSize(void) { return 0; }
+void s4642286_tsk_CAGJoystick_init(void) {}
+void s4642286_tsk_CAGSimulator_init(void) {}
+int s4642286_hamming_pipeline_get_mode(void) { return HAMMING_PIPELINE_DECODE; }
+
+static void debug_putc(char c) {
+	(void) c;
+	outputChars++;
+}
+
+/*
+ * Nanoseconds since an arbitrary point.
+ */
+static uint64_t now_ns(void) {
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (uint64_t) time.tv_sec * 1000000000u + time.tv_nsec;
+}
+
+static uint32_t randomState = 0x3010;
+
+/*
+ * xorshift32, so runs are repeatable.
+ */
+static uint32_t random_next(void) {
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+/*
+ * Write the next generated command: mostly lifeforms, with start and stop mixed in.
+ */
+static void generate(char *line, size_t size) {
+	int x = random_next() % SIMULATION_WIDTH;
+	int y = random_next() % SIMULATION_HEIGHT;
+
+	switch (random_next() % 10) {
+		case 0: case 1: case 2: case 3:
+			snprintf(line, size, "still %d %d %d", (int) (random_next() % 3), x, y);
+			break;
+		case 4: case 5:
+			snprintf(line, size, "osc %d %d %d", (int) (random_next() % 3), x, y);
+			break;
+		case 6: case 7:
+			snprintf(line, size, "glider %d %d", x, y);
+			break;
+		case 8:
+			snprintf(line, size, "start");
+			break;
+		default:
+			snprintf(line, size, "stop");
+			break;
+	}
+}
+
+/**
+ * @brief A struct for the replay results. Times are in nanoseconds.
+ *
+ */
+typedef struct {
+	unsigned long commands;
+	uint64_t total;             // Whole replay
+	uint64_t latencySum;        // End of line to board update
+	uint64_t latencyMax;
+	uint64_t criticalMax;       // Longest output loop
+	unsigned long chunks;       // Output chunks (FreeRTOS_CLIProcessCommand calls)
+	unsigned long inputChars;   // Command characters, with the '\r'
+} replay_t;
+
+/*
+ * Run one command line through the CLI task's command path and the
+ * simulator's SimQueue receive.
+ */
+static void replay_command(const char *commandString, replay_t *replay) {
+	static char outputString[configCOMMAND_INT_MAX_OUTPUT_SIZE];
+	BaseType_t xReturned = pdTRUE;
+	uint64_t start = now_ns(), criticalStart, elapsed;
+	int i;
+
+	// s4642286TaskCAGMnemonic: process, then write the output with interrupts disabled.
+	while (xReturned != pdFALSE) {
+		xReturned = FreeRTOS_CLIProcessCommand(commandString, outputString, configCOMMAND_INT_MAX_OUTPUT_SIZE);
+
+		criticalStart = now_ns();
+		for (i = 0; i < (int) strlen(outputString); i++) {
+			debug_putc(*(outputString + i));
+		}
+		elapsed = now_ns() - criticalStart;
+		if (elapsed > replay->criticalMax) {
+			replay->criticalMax = elapsed;
+		}
+		replay->chunks++;
+	}
+
+	// s4642286TaskCAGSimulator: receive the messages and draw them.
+	for (i = 0; i < simQueueCount; i++) {
+		s4642286_CAG_engine_add_life(board, simQueue[i].type, simQueue[i].cell_x, simQueue[i].cell_y);
+		messages++;
+	}
+	simQueueCount = 0;
+	simBits = 0;
+
+	elapsed = now_ns() - start;
+	replay->latencySum += elapsed;
+	if (elapsed > replay->latencyMax) {
+		replay->latencyMax = elapsed;
+	}
+	replay->commands++;
+	replay->inputChars += strlen(commandString) + 1;
+}
+
+/*
+ * Print the replay results.
+ */
+static void report(const replay_t *replay) {
+	double perCommand = (double) replay->inputChars / replay->commands;
+	double chunks = (double) replay->chunks / replay->commands;
+
+	printf("replayed %lu commands (%lu to the board, %lu rejected lines)\n",
+		replay->commands, messages, rejected);
+	printf("  host:   %.0f commands/s, latency to board update %.0f ns avg, %llu ns max\n",
+		replay->commands / (replay->total * 1e-9), (double) replay->latencySum / replay->commands,
+		(unsigned long long) replay->latencyMax);
+	printf("  host:   longest output loop (interrupts disabled on the target) %llu ns, %lu output chars\n",
+		(unsigned long long) replay->criticalMax, outputChars);
+	printf("  target: task delays add %.0f ms per command (%.1f chars x %d ms, %.1f chunks x %d ms, up to %d ms simulator)\n",
+		perCommand * MNEMONIC_POLL_MS + chunks * MNEMONIC_CHUNK_MS + SIMULATOR_POLL_MS,
+		perCommand, MNEMONIC_POLL_MS, chunks, MNEMONIC_CHUNK_MS, SIMULATOR_POLL_MS);
+	printf("          so at most %.1f commands/s; run cli_replay.py for the measured figures\n",
+		1000.0 / (perCommand * MNEMONIC_POLL_MS + chunks * MNEMONIC_CHUNK_MS));
+}
+
+int main(int argc, char **argv) {
+	char line[BENCH_MAX_INPUT + 2];
+	replay_t replay;
+	unsigned long count = BENCH_COMMANDS, i;
+	FILE *file = NULL;
+	uint64_t start;
+	size_t length;
+
+	if (argc == 3 && strcmp(argv[1], "-p") == 0) {
+		count = strtoul(argv[2], NULL, 0);
+		for (i = 0; i < count; i++) {
+			generate(line, sizeof(line));
+			printf("%s\n", line);
+		}
+		return 0;
+	}
+
+	if (argc == 3 && strcmp(argv[1], "-f") == 0) {
+		file = fopen(argv[2], "r");
+		if (file == NULL) {
+			perror(argv[2]);
+			return 1;
+		}
+	} else if (argc == 2) {
+		count = strtoul(argv[1], NULL, 0);
+	} else if (argc != 1) {
+		fprintf(stderr, "usage: %s [commands] | -f FILE | -p N\n", argv[0]);
+		return 2;
+	}
+
+	s4642286_cli_init();
+	s4642286_CAG_engine_reset(board);
+	SimQueue = (QueueHandle_t) &SimQueue;
+	specialFunctions = (EventGroupHandle_t) &specialFunctions;
+	memset(&replay, 0, sizeof(replay));
+
+	start = now_ns();
+	for (i = 0; file != NULL || i < count; i++) {
+		if (file != NULL) {
+			if (fgets(line, sizeof(line), file) == NULL) {
+				break;
+			}
+			length = strcspn(line, "\r\n");
+			if (line[length] == '\0' && !feof(file)) {
+				// Longer than the CLI task accepts: skip the rest of the line.
+				while (fgets(line, sizeof(line), file) != NULL && line[strcspn(line, "\r\n")] == '\0');
+				rejected++;
+				continue;
+			}
+			line[length] = '\0';
+		} else {
+			generate(line, sizeof(line));
+		}
+
+		replay_command(line, &replay);
+
+		// Start from an empty board now and then, as the clear command would.
+		if ((i & 0xFF) == 0xFF) {
+			s4642286_CAG_engine_reset(board);
+		}
+	}
+	replay.total = now_ns() - start;
+
+	if (file != NULL) {
+		fclose(file);
+	}
+	if (replay.commands == 0) {
+		fprintf(stderr, "no commands replayed\n");
+		return 1;
+	}
+
+	report(&replay);
+	return 0;
+}
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Replay CAG Mnemonic CLI commands on the target and time them.
+
+Usage:
+  ./bench_cli_CAG_mnemonic -p 2000 > replay.txt
+  python3 cli_replay.py /dev/ttyACM0 replay.txt
+
+Put the board in mnemonic mode first (the user button toggles it). Each
+command line is sent with a '\\r', and the command is complete once the task
+has echoed the line, sent '\\n' and written the reply (every reply ends in
+\\r\\n). The board update follows on the simulator's next SimQueue receive,
+at most 10 ms later. Reported: commands/s, the average and worst time from
+sending a line to the end of its reply, and the target's clistat (command count,
+processing time and the longest interrupt-disabled output loop).
+
+Needs pyserial (pip install pyserial).
+"""
+
+import sys
+import time
+
+import serial
+
+BAUD = 115200
+
+# Longest a command may take before the replay gives up (each character is
+# read on its own 50 ms task pass).
+COMMAND_TIMEOUT = 5.0
+
+
+def read_until_lines(port, lines, timeout):
+    """Read until the given number of '\\n' have arrived, or the timeout."""
+    seen = 0
+    deadline = time.monotonic() + timeout
+    while seen < lines and time.monotonic() < deadline:
+        data = port.read(port.in_waiting or 1)
+        seen += data.count(b"\n")
+    return seen >= lines
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: cli_replay.py PORT COMMAND_FILE")
+
+    with open(sys.argv[2]) as file:
+        commands = [line.strip() for line in file if line.strip()]
+
+    port = serial.Serial(sys.argv[1], BAUD, timeout=0.05)
+    port.reset_input_buffer()
+
+    latencies = []
+    timeouts = 0
+    start = time.monotonic()
+
+    for number, command in enumerate(commands, 1):
+        port.write(command.encode())
+        port.write(b"\r")
+        sent = time.monotonic()
+
+        # The echoed line ends in '\n', then the reply ends in '\n'.
+        if read_until_lines(port, 2, COMMAND_TIMEOUT):
+            latencies.append(time.monotonic() - sent)
+        else:
+            timeouts += 1
+            print("timeout on command %d: %s" % (number, command), file=sys.stderr)
+
+        if number % 100 == 0:
+            print("%d/%d commands" % (number, len(commands)), file=sys.stderr)
+
+    total = time.monotonic() - start
+
+    print("replayed %d commands in %.1f s: %.2f commands/s" % (len(commands), total, len(commands) / total))
+    if latencies:
+        print("line sent to end of reply: %.1f ms avg, %.1f ms max (%d timeouts)" % (
+            1000 * sum(latencies) / len(latencies), 1000 * max(latencies), timeouts))
+
+    # The target's own timing of the command path.
+    port.reset_input_buffer()
+    port.write(b"clistat\r")
+    time.sleep(COMMAND_TIMEOUT)
+    print(port.read(port.in_waiting).decode(errors="replace").replace("\r", ""))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,312 @@
+ /**
+ **************************************************************
+ * @file test/fuzz_cli_CAG_mnemonic.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host fuzz target for the CAG Mnemonic CLI commands
+ ***************************************************************
+ * Each input is one command line. It is dispatched by the FreeRTOS+CLI
+ * stand-in (stubs/FreeRTOS_CLI.c: command name match, then parameter count
+ * check) to the still, osc, glider, heap or hamstat handler. The SimQueue stub hands every message straight to
+ * the CAG engine, which draws the lifeform on a heap board of exactly
+ * SIMULATION_WIDTH * SIMULATION_HEIGHT cells, so ASan reports any write
+ * that escapes the board.
+ *
+ * Build with clang -fsanitize=fuzzer,address (make fuzz) for libFuzzer, or
+ * with gcc and ASan/UBSan (make fuzz_cli_CAG_mnemonic), which links the
+ * driver below instead:
+ *  fuzz_cli_CAG_mnemonic FILE...      - run each file (crash replay, AFL)
+ *  fuzz_cli_CAG_mnemonic -            - run stdin (AFL)
+ *  fuzz_cli_CAG_mnemonic -n N [SEED]  - run N generated command lines
+ ***************************************************************
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The handlers are private to the CLI module.
+#include "../mylib/s4642286_cli_CAG_mnemonic.c"
+
+// Longest command line the CLI task accepts (cInputString[100] and a NUL).
+#define FUZZ_MAX_INPUT 99
+
+// Board the SimQueue stub draws on (exact size, on the heap).
+static int (*board)[SIMULATION_HEIGHT];
+
+// Number of messages that reached the engine.
+static unsigned long messages;
+
+uint32_t SystemCoreClock = 180000000;
+
+/*
+ * The SimQueue stub: check the message the handler accepted and add it to the board.
+ */
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void *item, TickType_t wait) {
+
+	const caMessage_t *message = item;
+
+	(void) queue;
+	(void) wait;
+
+	// A handler must only send lifeforms that fit the simulator's type and position range.
+	if (message->cell_x < 0 || message->cell_x >= SIMULATION_WIDTH ||
+			message->cell_y < 0 || message->cell_y >= SIMULATION_HEIGHT ||
+			!((message->type >= STILL_BLOCK && message->type <= STILL_LOAF) ||
+			(message->type >= OSC_BLINKER && message->type <= OSC_BEACON) ||
+			message->type == SPACESHIP_GLIDER)) {
+		fprintf(stderr, "accepted bad message: type 0x%x at (%d, %d)\n",
+				message->type, message->cell_x, message->cell_y);
+		abort();
+	}
+
+	s4642286_CAG_engine_add_life(board, message->type, message->cell_x, message->cell_y);
+	messages++;
+	return pdPASS;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t wait) {
+	return xQueueSendToFront(queue, item, wait);
+}
+
+/*
+ * The task commands are not fuzzed (apart from heap); these only satisfy the linker.
+ */
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits) {
+	(void) group;
+	return bits;
+}
+
+TickType_t xTaskGetTickCount(void) { return 0; }
+void vTaskDelete(TaskHandle_t task) { (void) task; }
+eTaskState eTaskGetState(TaskHandle_t task) { (void) task; return eRunning; }
+void vTaskList(char *buffer) { buffer[0] = '\0'; }
+
+/*
+ * Enough tasks with full length names that the heap command's task list does
+ * not fit in its output buffer.
+ */
+#define FUZZ_TASKS 24
+
+UBaseType_t uxTaskGetNumberOfTasks(void) { return FUZZ_TASKS; }
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, UBaseType_t size, uint32_t *runTime) {
+	UBaseType_t i;
+
+	(void) runTime;
+	for (i = 0; i < size; i++) {
+		status[i].pcTaskName = "FIFTEEN_CHARS_X";
+		status[i].usStackHighWaterMark = 65535;
+	}
+	return size;
+}
+void *pvPortMalloc(size_t size) { return malloc(size); }
+void vPortFree(void *pointer) { free(pointer); }
+size_t xPortGetFreeHeapSize(void) { return 0; }
+size_t xPortGetMinimumEverFreeHeapSize(void) { return 0; }
+void s4642286_tsk_CAGJoystick_init(void) {}
+void s4642286_tsk_CAGSimulator_init(void) {}
+int s4642286_hamming_pipeline_get_mode(void) { return HAMMING_PIPELINE_DECODE; }
+
+/*
+ * Register the commands, create the board and make SimQueue non-NULL.
+ */
+static void fuzz_init(void) {
+
+	if (board != NULL) {
+		return;
+	}
+
+	s4642286_cli_init();
+	board = malloc(sizeof(int) * SIMULATION_WIDTH * SIMULATION_HEIGHT);
+	s4642286_CAG_engine_reset(board);
+	SimQueue = (QueueHandle_t) &SimQueue;
+
+	// Longest possible hamstat output.
+	memset(&hammingPipelineStats, 0xFF, sizeof(hammingPipelineStats));
+}
+
+/*
+ * Run one command line through the still, osc, glider, heap and hamstat commands.
+ */
+static void fuzz_command(const char *commandString) {
+
+	static const char *fuzzed[] = {"still", "osc", "glider", "heap", "hamstat"};
+	char *output;
+	size_t length;
+	unsigned int i;
+
+	for (i = 0; i < sizeof(fuzzed) / sizeof(fuzzed[0]); i++) {
+
+		length = strlen(fuzzed[i]);
+		if (strncmp(commandString, fuzzed[i], length) != 0 ||
+				(commandString[length] != ' ' && commandString[length] != '\0')) {
+			continue;
+		}
+
+		// Exact size output buffer, so an overlong reply is caught too.
+		output = malloc(configCOMMAND_INT_MAX_OUTPUT_SIZE);
+		while (FreeRTOS_CLIProcessCommand(commandString, output, configCOMMAND_INT_MAX_OUTPUT_SIZE) != pdFALSE);
+		free(output);
+		return;
+	}
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+
+	char *commandString;
+
+	fuzz_init();
+
+	// The CLI task never passes more than its input buffer, and never a NUL inside it.
+	if (size > FUZZ_MAX_INPUT || memchr(data, '\0', size) != NULL) {
+		return 0;
+	}
+
+	commandString = malloc(size + 1);
+	memcpy(commandString, data, size);
+	commandString[size] = '\0';
+
+	fuzz_command(commandString);
+
+	free(commandString);
+	return 0;
+}
+
+#ifndef FUZZ_LIBFUZZER
+
+/*
+ * Standalone driver (gcc has no libFuzzer).
+ */
+
+// Words the generator builds command lines from.
+static const char *fuzzWords[] = {
+	"still", "osc", "glider", "heap", "hamstat", "start", "", " ", "0", "1", "2", "3", "-1", "-2",
+	"31", "32", "62", "63", "64", "65", "14", "15", "16", "17", "127", "128",
+	"2147483647", "2147483648", "-2147483648", "4294967296", "99999999999",
+	"+1", "-0", "0x10", "1e3", "abc", "1a", "\t", "--", "%s%n",
+};
+
+#define FUZZ_NUM_WORDS (sizeof(fuzzWords) / sizeof(fuzzWords[0]))
+
+static uint32_t fuzzState;
+
+static uint32_t fuzz_random(void) {
+
+	fuzzState ^= fuzzState << 13;
+	fuzzState ^= fuzzState >> 17;
+	fuzzState ^= fuzzState << 5;
+	return fuzzState;
+}
+
+/*
+ * Build a command line from random words, then flip a few of its bytes. Most
+ * lines are a fuzzed command with the right number of parameters, so they
+ * get past the parameter count check.
+ */
+static size_t fuzz_generate(uint8_t *data) {
+
+	static const char *names[] = {"still", "osc", "glider"};
+	static const int parameters[] = {3, 3, 2};
+	size_t size = 0;
+	size_t length;
+	int command = fuzz_random() % 3;
+	int words;
+	int mutations;
+	const char *word;
+
+	if (fuzz_random() % 4 != 0) {
+		words = parameters[command];
+		length = strlen(names[command]);
+		memcpy(data, names[command], length);
+		size = length;
+		data[size++] = ' ';
+	} else {
+		words = 1 + fuzz_random() % 5;
+	}
+
+	while (words-- > 0) {
+		word = fuzzWords[fuzz_random() % FUZZ_NUM_WORDS];
+		length = strlen(word);
+		if (size + length + 1 > FUZZ_MAX_INPUT) {
+			break;
+		}
+		memcpy(data + size, word, length);
+		size += length;
+		if (words > 0 || fuzz_random() % 4 == 0) {
+			data[size++] = ' ';
+		}
+	}
+
+	mutations = (fuzz_random() % 4 == 0) ? 1 + fuzz_random() % 3 : 0;
+	while (mutations-- > 0 && size > 0) {
+		data[fuzz_random() % size] = (uint8_t) (1 + fuzz_random() % 255);
+	}
+
+	return size;
+}
+
+/*
+ * Run one input file ("-" for stdin).
+ */
+static int fuzz_file(const char *name) {
+
+	uint8_t data[FUZZ_MAX_INPUT + 1];
+	FILE *file = (strcmp(name, "-") == 0) ? stdin : fopen(name, "rb");
+	size_t size;
+
+	if (file == NULL) {
+		perror(name);
+		return 1;
+	}
+
+	size = fread(data, 1, sizeof(data), file);
+	if (file != stdin) {
+		fclose(file);
+	}
+
+	LLVMFuzzerTestOneInput(data, size);
+	return 0;
+}
+
+int main(int argc, char **argv) {
+
+	uint8_t data[FUZZ_MAX_INPUT];
+	unsigned long iterations;
+	unsigned long i;
+	int status = 0;
+	int arg;
+
+	if (argc >= 3 && strcmp(argv[1], "-n") == 0) {
+		iterations = strtoul(argv[2], NULL, 0);
+		fuzzState = (argc >= 4) ? (uint32_t) strtoul(argv[3], NULL, 0) : 0x3010u;
+		if (fuzzState == 0) {
+			fuzzState = 1;
+		}
+
+		for (i = 0; i < iterations; i++) {
+			LLVMFuzzerTestOneInput(data, fuzz_generate(data));
+
+			// Start from an empty board now and then, so lifeforms keep landing on dead cells.
+			if ((i & 0xFF) == 0xFF) {
+				s4642286_CAG_engine_reset(board);
+			}
+		}
+		printf("fuzz_cli_CAG_mnemonic: %lu inputs, %lu messages to the engine\n", iterations, messages);
+		return 0;
+	}
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s FILE... | - | -n ITERATIONS [SEED]\n", argv[0]);
+		return 2;
+	}
+
+	for (arg = 1; arg < argc; arg++) {
+		status |= fuzz_file(argv[arg]);
+	}
+	printf("fuzz_cli_CAG_mnemonic: %d inputs, %lu messages to the engine\n", argc - 1, messages);
+	return status;
+}
+
+#endif
@@ -0,0 +1,37 @@
+ /**
+ **************************************************************
+ * @file test/stubs/FreeRTOS.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host stand-in for the FreeRTOS types used by mylib. The test that
+ * 		  links a module defines the functions it calls.
+ ***************************************************************
+ */
+
+#ifndef TEST_STUB_FREERTOS_H
+#define TEST_STUB_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef unsigned long TickType_t;     // uint32_t is unsigned long on the target
+typedef TickType_t portTickType;
+typedef uint32_t StackType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS 1
+#define pdFAIL 0
+
+#define tskIDLE_PRIORITY 0
+#define configMINIMAL_STACK_SIZE 128
+#define configCOMMAND_INT_MAX_OUTPUT_SIZE 300
+
+extern void *pvPortMalloc(size_t size);
+extern void vPortFree(void *pointer);
+extern size_t xPortGetFreeHeapSize(void);
+extern size_t xPortGetMinimumEverFreeHeapSize(void);
+
+#endif
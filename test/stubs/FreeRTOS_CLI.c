@@ -0,0 +1,133 @@
+ /**
+ **************************************************************
+ * @file test/stubs/FreeRTOS_CLI.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host stand-in for FreeRTOS+CLI. Commands are matched, counted and
+ * 		  dispatched the way FreeRTOS_CLI.c does it, including writing the
+ * 		  parameter length and remembering a command that returns pdTRUE until
+ * 		  it has written all of its output. The built in help command is left out.
+ ***************************************************************
+ */
+
+#include <string.h>
+#include "FreeRTOS_CLI.h"
+
+// Most commands that can be registered.
+#define CLI_MAX_COMMANDS 20
+
+static const CLI_Command_Definition_t *commands[CLI_MAX_COMMANDS];
+static int numCommands;
+
+BaseType_t FreeRTOS_CLIRegisterCommand(const CLI_Command_Definition_t * const command) {
+
+	if (numCommands == CLI_MAX_COMMANDS) {
+		return pdFAIL;
+	}
+	commands[numCommands++] = command;
+	return pdPASS;
+}
+
+/*
+ * Count the parameters in a command line (runs of spaces, less a trailing one).
+ */
+static int cli_parameter_count(const char *commandString) {
+
+	int count = 0;
+	int lastWasSpace = 0;
+
+	for (; *commandString != '\0'; commandString++) {
+		if (*commandString == ' ') {
+			if (!lastWasSpace) {
+				count++;
+				lastWasSpace = 1;
+			}
+		} else {
+			lastWasSpace = 0;
+		}
+	}
+
+	if (lastWasSpace) {
+		count--;
+	}
+	return count;
+}
+
+BaseType_t FreeRTOS_CLIProcessCommand(const char * const pcCommandInput, char *pcWriteBuffer,
+		size_t xWriteBufferLen) {
+
+	static const CLI_Command_Definition_t *command = NULL;
+	BaseType_t result = pdTRUE;
+	size_t length;
+	int i;
+
+	// Find the command, unless the last one has more output to write.
+	if (command == NULL) {
+		for (i = 0; i < numCommands; i++) {
+			length = strlen(commands[i]->pcCommand);
+			if (strncmp(pcCommandInput, commands[i]->pcCommand, length) == 0 &&
+					(pcCommandInput[length] == ' ' || pcCommandInput[length] == '\0')) {
+				command = commands[i];
+				if (command->cExpectedNumberOfParameters >= 0 &&
+						cli_parameter_count(pcCommandInput) != command->cExpectedNumberOfParameters) {
+					result = pdFALSE;
+				}
+				break;
+			}
+		}
+	}
+
+	if (command != NULL && result == pdFALSE) {
+		strncpy(pcWriteBuffer, "Incorrect command parameter(s).  Enter \"help\" to view a list of available commands.\r\n\r\n",
+			xWriteBufferLen);
+		command = NULL;
+	} else if (command != NULL) {
+		result = command->pxCommandInterpreter(pcWriteBuffer, xWriteBufferLen, pcCommandInput);
+		if (result == pdFALSE) {
+			command = NULL;
+		}
+	} else {
+		strncpy(pcWriteBuffer, "Command not recognised.  Enter 'help' to view a list of available commands.\r\n\r\n",
+			xWriteBufferLen);
+		result = pdFALSE;
+	}
+
+	return result;
+}
+
+const char *FreeRTOS_CLIGetParameter(const char *pcCommandString, UBaseType_t uxWantedParameter,
+		BaseType_t *pxParameterStringLength) {
+
+	UBaseType_t found = 0;
+	const char *parameter = NULL;
+
+	*pxParameterStringLength = 0;
+
+	while (found < uxWantedParameter) {
+
+		// Skip the current word, then the spaces after it.
+		while (*pcCommandString != '\0' && *pcCommandString != ' ') {
+			pcCommandString++;
+		}
+		while (*pcCommandString == ' ') {
+			pcCommandString++;
+		}
+
+		if (*pcCommandString == '\0') {
+			break;
+		}
+
+		if (++found == uxWantedParameter) {
+			parameter = pcCommandString;
+			while (*pcCommandString != '\0' && *pcCommandString != ' ') {
+				(*pxParameterStringLength)++;
+				pcCommandString++;
+			}
+			if (*pxParameterStringLength == 0) {
+				parameter = NULL;
+			}
+		}
+	}
+
+	return parameter;
+}
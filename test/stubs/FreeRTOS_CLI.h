@@ -0,0 +1,30 @@
+ /**
+ **************************************************************
+ * @file test/stubs/FreeRTOS_CLI.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host stand-in for the FreeRTOS+CLI API (FreeRTOS_CLI.c)
+ ***************************************************************
+ */
+
+#ifndef TEST_STUB_FREERTOS_CLI_H
+#define TEST_STUB_FREERTOS_CLI_H
+
+#include "FreeRTOS.h"
+
+typedef BaseType_t (*pdCOMMAND_LINE_CALLBACK)(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+
+typedef struct {
+    const char * const pcCommand;
+    const char * const pcHelpString;
+    const pdCOMMAND_LINE_CALLBACK pxCommandInterpreter;
+    int8_t cExpectedNumberOfParameters;
+} CLI_Command_Definition_t;
+
+extern BaseType_t FreeRTOS_CLIRegisterCommand(const CLI_Command_Definition_t * const command);
+extern BaseType_t FreeRTOS_CLIProcessCommand(const char * const pcCommandInput, char *pcWriteBuffer,
+        size_t xWriteBufferLen);
+extern const char *FreeRTOS_CLIGetParameter(const char *pcCommandString, UBaseType_t uxWantedParameter,
+        BaseType_t *pxParameterStringLength);
+
+#endif
@@ -0,0 +1,19 @@
+ /**
+ **************************************************************
+ * @file test/stubs/board.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host stand-in for the board support header
+ ***************************************************************
+ */
+
+#ifndef TEST_STUB_BOARD_H
+#define TEST_STUB_BOARD_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+extern uint32_t SystemCoreClock;
+
+#endif
@@ -0,0 +1,17 @@
+ /**
+ **************************************************************
+ * @file test/stubs/debug_log.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host stand-in for the debug log header
+ ***************************************************************
+ */
+
+#ifndef TEST_STUB_DEBUG_LOG_H
+#define TEST_STUB_DEBUG_LOG_H
+
+#include <stdio.h>
+
+#define debug_log(...) printf(__VA_ARGS__)
+
+#endif
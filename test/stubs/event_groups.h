@@ -0,0 +1,20 @@
+ /**
+ **************************************************************
+ * @file test/stubs/event_groups.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host stand-in for the FreeRTOS event group API
+ ***************************************************************
+ */
+
+#ifndef TEST_STUB_EVENT_GROUPS_H
+#define TEST_STUB_EVENT_GROUPS_H
+
+#include "FreeRTOS.h"
+
+typedef void *EventGroupHandle_t;
+typedef uint32_t EventBits_t;
+
+extern EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits);
+
+#endif
@@ -0,0 +1,13 @@
+ /**
+ **************************************************************
+ * @file test/stubs/processor_hal.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host stand-in for the processor HAL header (no registers)
+ ***************************************************************
+ */
+
+#ifndef TEST_STUB_PROCESSOR_HAL_H
+#define TEST_STUB_PROCESSOR_HAL_H
+
+#endif
@@ -0,0 +1,20 @@
+ /**
+ **************************************************************
+ * @file test/stubs/queue.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host stand-in for the FreeRTOS queue API
+ ***************************************************************
+ */
+
+#ifndef TEST_STUB_QUEUE_H
+#define TEST_STUB_QUEUE_H
+
+#include "FreeRTOS.h"
+
+typedef void *QueueHandle_t;
+
+extern BaseType_t xQueueSendToFront(QueueHandle_t queue, const void *item, TickType_t wait);
+extern BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t wait);
+
+#endif
@@ -0,0 +1,17 @@
+ /**
+ **************************************************************
+ * @file test/stubs/semphr.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host stand-in for the FreeRTOS semaphore API
+ ***************************************************************
+ */
+
+#ifndef TEST_STUB_SEMPHR_H
+#define TEST_STUB_SEMPHR_H
+
+#include "queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+#endif
@@ -0,0 +1,42 @@
+ /**
+ **************************************************************
+ * @file test/stubs/task.h
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host stand-in for the FreeRTOS task API
+ ***************************************************************
+ */
+
+#ifndef TEST_STUB_TASK_H
+#define TEST_STUB_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+typedef enum {
+    eRunning = 0,
+    eReady,
+    eBlocked,
+    eSuspended,
+    eDeleted,
+    eInvalid
+} eTaskState;
+
+typedef struct {
+    TaskHandle_t xHandle;
+    const char *pcTaskName;
+    UBaseType_t xTaskNumber;
+    eTaskState eCurrentState;
+    UBaseType_t uxCurrentPriority;
+    uint16_t usStackHighWaterMark;
+} TaskStatus_t;
+
+extern TickType_t xTaskGetTickCount(void);
+extern void vTaskDelete(TaskHandle_t task);
+extern eTaskState eTaskGetState(TaskHandle_t task);
+extern void vTaskList(char *buffer);
+extern UBaseType_t uxTaskGetNumberOfTasks(void);
+extern UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, UBaseType_t size, uint32_t *runTime);
+
+#endif
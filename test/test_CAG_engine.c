@@ -0,0 +1,408 @@
+ /**
+ **************************************************************
+ * @file test/test_CAG_engine.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host tests for the CAG engine
+ ***************************************************************
+ * Usage:
+ *   test_CAG_engine <golden file> [random boards]  - run the tests
+ *   test_CAG_engine -g <golden file>               - write the golden boards
+ *
+ * 1. Golden boards: every lifeform is placed in the middle of the board and
+ *    in two corners (where it is clipped), and the boards after a number of
+ *    generations are compared with the stored boards.
+ * 2. Behaviour: still lifes must not change, oscillators must have period 2
+ *    and the glider must move one cell diagonally every 4 generations. These
+ *    do not depend on the golden file, so they catch a bad regeneration.
+ * 3. Differential: random boards are advanced by the engine under test and by
+ *    an independent reference kernel, which must agree on every cell.
+ *    Define ENGINE_UNDER_TEST to test a different engine. The population
+ *    count is checked against the reference board after every generation.
+ ***************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "s4642286_CAG_engine.h"
+
+#ifndef ENGINE_UNDER_TEST
+#define ENGINE_UNDER_TEST s4642286_CAG_engine_step
+#endif
+
+// Default number of random boards for the differential test.
+#define DIFF_BOARDS 25000
+
+// Generations in each random board's chain (errors can show up late).
+#define DIFF_CHAIN 4
+
+typedef int board_t[SIMULATION_WIDTH][SIMULATION_HEIGHT];
+
+/**
+ * @brief A struct for one lifeform placement in the golden file.
+ *
+ */
+typedef struct {
+	const char *name;
+	int type;
+} lifeform_t;
+
+static const lifeform_t lifeforms[] = {
+	{ "CELL_ALIVE", CELL_ALIVE },
+	{ "STILL_BLOCK", STILL_BLOCK },
+	{ "STILL_BEEHIVE", STILL_BEEHIVE },
+	{ "STILL_LOAF", STILL_LOAF },
+	{ "OSC_BLINKER", OSC_BLINKER },
+	{ "OSC_TOAD", OSC_TOAD },
+	{ "OSC_BEACON", OSC_BEACON },
+	{ "SPACESHIP_GLIDER", SPACESHIP_GLIDER }
+};
+#define NUM_LIFEFORMS ((int) (sizeof(lifeforms) / sizeof(lifeforms[0])))
+
+// Anchor cells, and the generations stored for each anchor.
+static const int anchors[][2] = { { 32, 8 }, { 0, 0 }, { SIMULATION_WIDTH - 1, SIMULATION_HEIGHT - 1 } };
+#define NUM_ANCHORS ((int) (sizeof(anchors) / sizeof(anchors[0])))
+static const int centreGenerations[] = { 0, 1, 2, 3, 4, 8 };
+static const int cornerGenerations[] = { 0, 1 };
+
+static int failures;
+
+/**
+ * @brief Reports a failed check.
+ *
+ * @param what description of the check.
+ */
+static void fail(const char *what) {
+	printf("FAIL: %s\n", what);
+	failures++;
+}
+
+/**
+ * @brief Places a lifeform on an empty board and advances it.
+ *
+ * @param board the board.
+ * @param type the lifeform type.
+ * @param x the anchor x coordinate.
+ * @param y the anchor y coordinate.
+ * @param generations the number of generations to advance.
+ */
+static void run_lifeform(board_t board, int type, int x, int y, int generations) {
+	board_t scratch;
+	int i;
+
+	s4642286_CAG_engine_reset(board);
+	s4642286_CAG_engine_add_life(board, type, x, y);
+	for (i = 0; i < generations; i++) {
+		s4642286_CAG_engine_step(board, scratch);
+	}
+}
+
+/**
+ * @brief Writes a board as SIMULATION_HEIGHT rows of '.' and '#'.
+ *
+ * @param file the output file.
+ * @param board the board.
+ */
+static void write_board(FILE *file, board_t board) {
+	int x, y;
+
+	for (y = 0; y < SIMULATION_HEIGHT; y++) {
+		for (x = 0; x < SIMULATION_WIDTH; x++) {
+			fputc(board[x][y] ? '#' : '.', file);
+		}
+		fputc('\n', file);
+	}
+}
+
+/**
+ * @brief Writes or checks every golden board.
+ *
+ * @param path the golden file.
+ * @param write 1 to write the file, 0 to check against it.
+ * @return int the number of boards written or checked, or -1 on a file error.
+ */
+static int golden(const char *path, int write) {
+	FILE *file = fopen(path, write ? "w" : "r");
+	char line[256], header[128], what[256];
+	board_t board;
+	const int *generations;
+	int numGenerations, l, a, g, x, y, count = 0;
+
+	if (file == NULL) {
+		perror(path);
+		return -1;
+	}
+
+	if (write) {
+		fprintf(file, "# CAG engine golden boards: <lifeform> <x> <y> <generation>, then the board\n"
+			"# ('#' alive) with row y = 0 first. Regenerate with 'make golden'.\n");
+	}
+
+	for (l = 0; l < NUM_LIFEFORMS; l++) {
+		for (a = 0; a < NUM_ANCHORS; a++) {
+			generations = (a == 0) ? centreGenerations : cornerGenerations;
+			numGenerations = (a == 0) ? (int) (sizeof(centreGenerations) / sizeof(int)) :
+				(int) (sizeof(cornerGenerations) / sizeof(int));
+
+			for (g = 0; g < numGenerations; g++) {
+				run_lifeform(board, lifeforms[l].type, anchors[a][0], anchors[a][1], generations[g]);
+				snprintf(header, sizeof(header), "%s %d %d %d", lifeforms[l].name, anchors[a][0],
+					anchors[a][1], generations[g]);
+				count++;
+
+				if (write) {
+					fprintf(file, "%s\n", header);
+					write_board(file, board);
+					continue;
+				}
+
+				// Skip comments, then expect this board's header.
+				do {
+					if (fgets(line, sizeof(line), file) == NULL) {
+						line[0] = '\0';
+						break;
+					}
+				} while (line[0] == '#');
+				line[strcspn(line, "\r\n")] = '\0';
+
+				if (strcmp(line, header) != 0) {
+					snprintf(what, sizeof(what), "golden file has '%s', expected '%s'", line, header);
+					fail(what);
+					fclose(file);
+					return count;
+				}
+
+				for (y = 0; y < SIMULATION_HEIGHT; y++) {
+					if (fgets(line, sizeof(line), file) == NULL) {
+						line[0] = '\0';
+					}
+					for (x = 0; x < SIMULATION_WIDTH; x++) {
+						if ((line[x] == '#') != (board[x][y] != 0)) {
+							snprintf(what, sizeof(what), "%s: cell (%d, %d) differs from golden", header, x, y);
+							fail(what);
+							x = SIMULATION_WIDTH;
+							y = SIMULATION_HEIGHT;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	fclose(file);
+	return count;
+}
+
+/**
+ * @brief Checks the behaviour of each lifeform placed in the middle of the board.
+ *
+ */
+static void check_behaviour(void) {
+	board_t start, board, later;
+	int l, g, x, y, cx, cy, same;
+	char what[128];
+
+	for (l = 0; l < NUM_LIFEFORMS; l++) {
+		run_lifeform(start, lifeforms[l].type, 32, 8, 0);
+
+		switch (lifeforms[l].type & 0xF0) {
+			case 0x20:
+				// Still lifes are unchanged after any number of generations.
+				for (g = 1; g <= 8; g++) {
+					run_lifeform(board, lifeforms[l].type, 32, 8, g);
+					if (memcmp(board, start, sizeof(board_t)) != 0) {
+						snprintf(what, sizeof(what), "%s changed at generation %d", lifeforms[l].name, g);
+						fail(what);
+						break;
+					}
+				}
+				break;
+
+			case 0x30:
+				// Oscillators repeat every 2 generations (from generation 1, as
+				// a partly drawn oscillator settles first) but not every 1.
+				run_lifeform(board, lifeforms[l].type, 32, 8, 1);
+				run_lifeform(later, lifeforms[l].type, 32, 8, 2);
+				if (memcmp(board, later, sizeof(board_t)) == 0) {
+					snprintf(what, sizeof(what), "%s did not oscillate", lifeforms[l].name);
+					fail(what);
+				}
+				for (g = 3; g <= 9; g += 2) {
+					run_lifeform(later, lifeforms[l].type, 32, 8, g);
+					if (memcmp(board, later, sizeof(board_t)) != 0) {
+						snprintf(what, sizeof(what), "%s has no period 2 at generation %d", lifeforms[l].name, g);
+						fail(what);
+						break;
+					}
+				}
+				break;
+
+			case 0x40:
+				// The glider moves one cell diagonally every 4 generations.
+				same = 0;
+				for (g = 1; g <= 3; g++) {
+					run_lifeform(board, lifeforms[l].type, 32, 8, 4 * g);
+					for (cy = -1; cy <= 1; cy += 2) {
+						for (cx = -1; cx <= 1; cx += 2) {
+							int match = 1;
+							for (x = 0; x < SIMULATION_WIDTH; x++) {
+								for (y = 0; y < SIMULATION_HEIGHT; y++) {
+									int sx = x - cx * g, sy = y - cy * g;
+									int was = (sx >= 0 && sx < SIMULATION_WIDTH && sy >= 0 &&
+										sy < SIMULATION_HEIGHT) ? start[sx][sy] : 0;
+									if (board[x][y] != was) {
+										match = 0;
+									}
+								}
+							}
+							same += match;
+						}
+					}
+				}
+				if (same != 3) {
+					fail("SPACESHIP_GLIDER did not move one cell diagonally every 4 generations");
+				}
+				break;
+
+			default:
+				// A single cell dies.
+				run_lifeform(board, lifeforms[l].type, 32, 8, 1);
+				for (x = 0; x < SIMULATION_WIDTH; x++) {
+					for (y = 0; y < SIMULATION_HEIGHT; y++) {
+						if (board[x][y] != 0) {
+							snprintf(what, sizeof(what), "%s did not die", lifeforms[l].name);
+							fail(what);
+							x = SIMULATION_WIDTH;
+							break;
+						}
+					}
+				}
+				break;
+		}
+	}
+}
+
+/**
+ * @brief Independent reference kernel: counts neighbours in a board with a
+ * 		  dead border, then applies B3/S23.
+ *
+ * @param board the board to advance by one generation.
+ */
+static void reference_step(board_t board) {
+	static unsigned char padded[SIMULATION_WIDTH + 2][SIMULATION_HEIGHT + 2];
+	int x, y, n;
+
+	memset(padded, 0, sizeof(padded));
+	for (x = 0; x < SIMULATION_WIDTH; x++) {
+		for (y = 0; y < SIMULATION_HEIGHT; y++) {
+			padded[x + 1][y + 1] = (board[x][y] == 1);
+		}
+	}
+
+	for (x = 1; x <= SIMULATION_WIDTH; x++) {
+		for (y = 1; y <= SIMULATION_HEIGHT; y++) {
+			n = padded[x - 1][y - 1] + padded[x][y - 1] + padded[x + 1][y - 1] +
+				padded[x - 1][y] + padded[x + 1][y] +
+				padded[x - 1][y + 1] + padded[x][y + 1] + padded[x + 1][y + 1];
+			board[x - 1][y - 1] = (n == 3) || (n == 2 && padded[x][y]);
+		}
+	}
+}
+
+/**
+ * @brief xorshift32 pseudo random number generator (repeatable runs).
+ *
+ * @return unsigned int the next random number.
+ */
+static unsigned int random_next(void) {
+	static unsigned int state = 0x2545F491;
+
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+/**
+ * @brief Advances random boards with the engine under test and the reference
+ * 		  kernel and compares them.
+ *
+ * @param numBoards the number of random boards.
+ */
+static void check_differential(long numBoards) {
+	board_t tested, expected, scratch;
+	long b, mismatches = 0;
+	int x, y, g, density, population;
+	clock_t start = clock();
+	double seconds;
+
+	for (b = 0; b < numBoards; b++) {
+		// Vary the density from 1/16 to 15/16 so sparse and crowded boards are both tested.
+		density = 1 + (b % 15);
+		for (x = 0; x < SIMULATION_WIDTH; x++) {
+			for (y = 0; y < SIMULATION_HEIGHT; y++) {
+				tested[x][y] = expected[x][y] = ((random_next() & 0x0F) < (unsigned int) density);
+			}
+		}
+
+		for (g = 0; g < DIFF_CHAIN; g++) {
+			ENGINE_UNDER_TEST(tested, scratch);
+			reference_step(expected);
+
+			if (memcmp(tested, expected, sizeof(board_t)) != 0) {
+				if (mismatches++ == 0) {
+					printf("FAIL: random board %ld differs from the reference at generation %d\n", b, g + 1);
+					failures++;
+				}
+				break;
+			}
+
+			// The population must match a count of the reference board.
+			population = 0;
+			for (x = 0; x < SIMULATION_WIDTH; x++) {
+				for (y = 0; y < SIMULATION_HEIGHT; y++) {
+					population += expected[x][y];
+				}
+			}
+			if (s4642286_CAG_engine_population(tested) != population) {
+				if (mismatches++ == 0) {
+					printf("FAIL: random board %ld has the wrong population at generation %d\n", b, g + 1);
+					failures++;
+				}
+				break;
+			}
+		}
+	}
+
+	seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+	printf("differential: %ld boards x %d generations, %ld mismatches (%.0f generations/s)\n",
+		numBoards, DIFF_CHAIN, mismatches, seconds > 0 ? (numBoards * DIFF_CHAIN) / seconds : 0.0);
+}
+
+int main(int argc, char **argv) {
+	long numBoards = DIFF_BOARDS;
+	int count;
+
+	if (argc == 3 && strcmp(argv[1], "-g") == 0) {
+		count = golden(argv[2], 1);
+		printf("wrote %d golden boards to %s\n", count, argv[2]);
+		return count < 0;
+	}
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s <golden file> [random boards] | -g <golden file>\n", argv[0]);
+		return 2;
+	}
+	if (argc > 2) {
+		numBoards = atol(argv[2]);
+	}
+
+	count = golden(argv[1], 0);
+	printf("golden: %d boards checked\n", count);
+	check_behaviour();
+	check_differential(numBoards);
+
+	printf("%s (%d failures)\n", failures ? "FAILED" : "PASSED", failures);
+	return failures != 0 || count < 0;
+}
@@ -0,0 +1,253 @@
+ /**
+ **************************************************************
+ * @file test/test_hamming.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host tests and benchmark for the Hamming codec
+ ***************************************************************
+ * Usage:
+ *   test_hamming [benchmark bytes]
+ *
+ * 1. Self test: s4642286_lib_hamming_selftest() must report no failures.
+ * 2. Buffers: s4642286_lib_hamming_buffer_encode/decode must match the byte
+ *    encoder and the SECDED decode for every buffer length up to 67 (all
+ *    word/tail splits), and the decoder must correct single bit errors, leave
+ *    double bit errors uncorrected and count both in the error array and the
+ *    stats.
+ * 3. Benchmark: bytes/s of the byte functions against the buffer functions.
+ ***************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "s4642286_hamming.h"
+
+// Longest buffer in the buffer tests.
+#define MAX_LENGTH 67
+
+// Default data bytes per benchmark pass, and the number of passes.
+#define BENCH_BYTES (1 << 20)
+#define BENCH_PASSES 8
+
+static int failures;
+
+// Stops the benchmark loops from being optimised away.
+static volatile unsigned char sink;
+
+static unsigned int randomState = 0x3010;
+
+/**
+ * @brief Reports a failed check.
+ *
+ * @param what description of the check.
+ */
+static void fail(const char *what) {
+	printf("FAIL: %s\n", what);
+	failures++;
+}
+
+/*
+ * xorshift32, so runs are repeatable.
+ */
+static unsigned int random_next(void) {
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+/*
+ * Byte at a time decode of one data byte (two codewords, low half byte first).
+ */
+static unsigned char byte_decode(const unsigned char *in) {
+	return (s4642286_lib_hamming_byte_decode(in[0]) >> 4) | (s4642286_lib_hamming_byte_decode(in[1]) & 0xF0);
+}
+
+/*
+ * SECDED decode of one data byte, which leaves double bit errors uncorrected.
+ */
+static unsigned char secded_decode(const unsigned char *in) {
+	return s4642286_lib_hamming_secded_decode(in[0]).data | (s4642286_lib_hamming_secded_decode(in[1]).data << 4);
+}
+
+/**
+ * @brief Checks the buffer functions against the byte functions, with and
+ * 		  without injected errors.
+ *
+ */
+static void test_buffers(void) {
+	unsigned char data[MAX_LENGTH], encoded[2 * MAX_LENGTH], decoded[MAX_LENGTH], errors[MAX_LENGTH];
+	unsigned short byteEncoded;
+	hammingStats_t stats;
+	char what[100];
+	int length, i, bit, other, count, round;
+
+	for (round = 0; round < 64; round++) {
+		for (length = 0; length <= MAX_LENGTH; length++) {
+			for (i = 0; i < length; i++) {
+				data[i] = random_next();
+			}
+
+			// Encode must match the byte encoder, low half byte first.
+			s4642286_lib_hamming_buffer_encode(data, encoded, length);
+			for (i = 0; i < length; i++) {
+				byteEncoded = s4642286_lib_hamming_byte_encode(data[i]);
+				if (encoded[2 * i] != (byteEncoded & 0xFF) || encoded[2 * i + 1] != (byteEncoded >> 8)) {
+					snprintf(what, sizeof(what), "buffer encode of byte %d (length %d)", i, length);
+					fail(what);
+				}
+			}
+
+			// Clean round trip.
+			memset(&stats, 0, sizeof(stats));
+			count = s4642286_lib_hamming_buffer_decode(encoded, decoded, length, errors, &stats);
+			if (count != 0 || memcmp(decoded, data, length) != 0 || stats.bytes != (unsigned long) length ||
+					stats.corrected || stats.doubleErrors || stats.parityErrors) {
+				snprintf(what, sizeof(what), "clean buffer decode (length %d)", length);
+				fail(what);
+			}
+			for (i = 0; i < length; i++) {
+				if (errors[i] != 0) {
+					snprintf(what, sizeof(what), "clean buffer decode error count %d (length %d)", i, length);
+					fail(what);
+				}
+			}
+
+			if (length == 0) {
+				continue;
+			}
+
+			// One single bit error (may be the parity bit) and one double bit error.
+			i = random_next() % (2 * length);
+			bit = random_next() % 8;
+			encoded[i] ^= 1 << bit;
+			other = (length > 1) ? (i + 1 + (int) (random_next() % (2 * length - 1))) % (2 * length) : -1;
+			if (other >= 0) {
+				encoded[other] ^= 0x03 << (random_next() % 7);
+			}
+
+			memset(&stats, 0, sizeof(stats));
+			count = s4642286_lib_hamming_buffer_decode(encoded, decoded, length, errors, &stats);
+
+			if (count != (other >= 0 ? 2 : 1) || stats.doubleErrors != (other >= 0 ? 1u : 0u) ||
+					stats.corrected + stats.parityErrors != 1 || stats.parityErrors != (bit == 0 ? 1u : 0u) ||
+					errors[i / 2] == 0 || (other >= 0 && errors[other / 2] == 0)) {
+				snprintf(what, sizeof(what), "buffer decode error counts (length %d)", length);
+				fail(what);
+			}
+
+			// The byte with the single bit error must be corrected, and the
+			// byte with the double bit error left as the SECDED decode leaves it.
+			for (i = 0; i < length; i++) {
+				if (decoded[i] != secded_decode(encoded + 2 * i) ||
+						(i != other / 2 && decoded[i] != data[i])) {
+					snprintf(what, sizeof(what), "buffer decode of byte %d with errors (length %d)", i, length);
+					fail(what);
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Seconds since an arbitrary point.
+ */
+static double now(void) {
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+/*
+ * Print one benchmark result (the best of the passes).
+ */
+static void report(const char *name, long bytes, double seconds) {
+	printf("  %-14s %8.1f MB/s\n", name, bytes / seconds / 1e6);
+}
+
+/**
+ * @brief Measures data bytes/s of the byte and buffer encode and decode.
+ *
+ * @param bytes data bytes per pass.
+ */
+static void benchmark(long bytes) {
+	unsigned char *data = malloc(bytes), *encoded = malloc(2 * bytes), *decoded = malloc(bytes);
+	double best[4] = { 1e9, 1e9, 1e9, 1e9 };
+	double start, seconds;
+	unsigned short value;
+	long i;
+	int pass;
+
+	for (i = 0; i < bytes; i++) {
+		data[i] = random_next();
+	}
+
+	for (pass = 0; pass < BENCH_PASSES; pass++) {
+		start = now();
+		for (i = 0; i < bytes; i++) {
+			value = s4642286_lib_hamming_byte_encode(data[i]);
+			encoded[2 * i] = value & 0xFF;
+			encoded[2 * i + 1] = value >> 8;
+		}
+		seconds = now() - start;
+		best[0] = seconds < best[0] ? seconds : best[0];
+
+		start = now();
+		s4642286_lib_hamming_buffer_encode(data, encoded, bytes);
+		seconds = now() - start;
+		best[1] = seconds < best[1] ? seconds : best[1];
+
+		start = now();
+		for (i = 0; i < bytes; i++) {
+			decoded[i] = byte_decode(encoded + 2 * i);
+		}
+		seconds = now() - start;
+		best[2] = seconds < best[2] ? seconds : best[2];
+
+		start = now();
+		s4642286_lib_hamming_buffer_decode(encoded, decoded, bytes, NULL, NULL);
+		seconds = now() - start;
+		best[3] = seconds < best[3] ? seconds : best[3];
+
+		sink ^= decoded[pass % bytes];
+	}
+
+	if (memcmp(decoded, data, bytes) != 0) {
+		fail("benchmark round trip");
+	}
+
+	printf("benchmark, %ld bytes, best of %d:\n", bytes, BENCH_PASSES);
+	report("byte_encode", bytes, best[0]);
+	report("buffer_encode", bytes, best[1]);
+	report("byte_decode", bytes, best[2]);
+	report("buffer_decode", bytes, best[3]);
+
+	free(data);
+	free(encoded);
+	free(decoded);
+}
+
+int main(int argc, char **argv) {
+	long bytes = (argc > 1) ? atol(argv[1]) : BENCH_BYTES;
+	int selftest;
+
+	if (bytes <= 0) {
+		fprintf(stderr, "usage: %s [benchmark bytes]\n", argv[0]);
+		return 2;
+	}
+
+	selftest = s4642286_lib_hamming_selftest();
+	printf("selftest: %d failures\n", selftest);
+	if (selftest != 0) {
+		fail("s4642286_lib_hamming_selftest");
+	}
+
+	test_buffers();
+	benchmark(bytes);
+
+	printf("%s (%d failures)\n", failures ? "FAILED" : "PASSED", failures);
+	return failures != 0;
+}
@@ -0,0 +1,176 @@
+ /**
+ **************************************************************
+ * @file test/test_hamming_ext.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host tests for the extended Hamming code family
+ ***************************************************************
+ * Usage:
+ *   test_hamming_ext
+ *
+ * For each code size m (HAMMING_EXT_M_MIN to HAMMING_EXT_M_MAX):
+ * 1. Self test: s4642286_lib_hamming_ext_selftest(m) must report no failures.
+ * 2. Buffers: s4642286_lib_hamming_ext_buffer_encode/decode must round trip
+ *    random buffers of every length up to 67 (all codeword/byte splits).
+ *    With one random bit error in some codewords the data must still round
+ *    trip, and with two in one codeword that codeword must be flagged. The
+ *    per codeword status, the return value and the stats must agree.
+ * 3. Invalid m is rejected by every function.
+ ***************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "s4642286_hamming_ext.h"
+
+// Longest buffer in the buffer tests.
+#define MAX_LENGTH 67
+
+// Largest encoded buffer and number of codewords (the (8,4) code).
+#define MAX_ENCODED HAMMING_EXT_ENCODED_SIZE(HAMMING_EXT_M_MIN, MAX_LENGTH)
+#define MAX_CODEWORDS HAMMING_EXT_CODEWORDS(HAMMING_EXT_M_MIN, MAX_LENGTH)
+
+static int failures;
+
+static unsigned int randomState = 0x3010;
+
+/**
+ * @brief Reports a failed check.
+ *
+ * @param what description of the check.
+ */
+static void fail(const char *what) {
+	printf("FAIL: %s\n", what);
+	failures++;
+}
+
+/*
+ * xorshift32, so runs are repeatable.
+ */
+static unsigned int random_next(void) {
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+/*
+ * Flip bit of a codeword in an encoded buffer (codewords are sent low byte first).
+ */
+static void flip_bit(int m, unsigned char *encoded, int codeword, int bit) {
+	encoded[codeword * (HAMMING_EXT_N(m) / 8) + bit / 8] ^= 1 << (bit % 8);
+}
+
+/**
+ * @brief Checks the buffer functions for one code size.
+ *
+ * @param m the code size.
+ */
+static void test_buffers(int m) {
+	unsigned char data[MAX_LENGTH], encoded[MAX_ENCODED], decoded[MAX_LENGTH];
+	unsigned char status[MAX_CODEWORDS];
+	hammingStats_t stats;
+	char what[128];
+	int length, size, codewords, n, expected, numErrors, corrected, bit1, bit2;
+
+	for (length = 0; length <= MAX_LENGTH; length++) {
+		codewords = HAMMING_EXT_CODEWORDS(m, length);
+		for (n = 0; n < length; n++) {
+			data[n] = random_next();
+		}
+
+		size = s4642286_lib_hamming_ext_buffer_encode(m, data, encoded, length);
+		if (size != HAMMING_EXT_ENCODED_SIZE(m, length)) {
+			snprintf(what, sizeof(what), "m %d length %d: encoded size %d", m, length, size);
+			fail(what);
+			continue;
+		}
+
+		// Clean round trip.
+		memset(&stats, 0, sizeof(stats));
+		numErrors = s4642286_lib_hamming_ext_buffer_decode(m, encoded, decoded, length, status, &stats);
+		if (numErrors != 0 || memcmp(decoded, data, length) != 0 || stats.bytes != (unsigned long) length) {
+			snprintf(what, sizeof(what), "m %d length %d: clean round trip", m, length);
+			fail(what);
+		}
+		for (n = 0; n < codewords; n++) {
+			if (status[n] != HAMMING_CLEAN) {
+				snprintf(what, sizeof(what), "m %d length %d: codeword %d not clean", m, length, n);
+				fail(what);
+			}
+		}
+		if (codewords == 0) {
+			continue;
+		}
+
+		// One bit error in every other codeword must be corrected.
+		expected = 0;
+		corrected = 0;
+		for (n = 0; n < codewords; n += 2) {
+			bit1 = random_next() % HAMMING_EXT_N(m);
+			flip_bit(m, encoded, n, bit1);
+			expected++;
+			corrected += (bit1 != 0);
+		}
+		memset(&stats, 0, sizeof(stats));
+		numErrors = s4642286_lib_hamming_ext_buffer_decode(m, encoded, decoded, length, status, &stats);
+		if (numErrors != expected || memcmp(decoded, data, length) != 0 ||
+				stats.corrected != (unsigned long) corrected ||
+				stats.parityErrors != (unsigned long) (expected - corrected) || stats.doubleErrors != 0) {
+			snprintf(what, sizeof(what), "m %d length %d: single bit errors (%d returned, %d expected)",
+				m, length, numErrors, expected);
+			fail(what);
+		}
+		for (n = 0; n < codewords; n++) {
+			if ((n % 2 == 0) != (status[n] == HAMMING_CORRECTED || status[n] == HAMMING_PARITY_ONLY)) {
+				snprintf(what, sizeof(what), "m %d length %d: codeword %d status %d", m, length, n, status[n]);
+				fail(what);
+			}
+		}
+
+		// Two bit errors in one codeword must be flagged.
+		s4642286_lib_hamming_ext_buffer_encode(m, data, encoded, length);
+		n = random_next() % codewords;
+		bit1 = random_next() % HAMMING_EXT_N(m);
+		bit2 = (bit1 + 1 + random_next() % (HAMMING_EXT_N(m) - 1)) % HAMMING_EXT_N(m);
+		flip_bit(m, encoded, n, bit1);
+		flip_bit(m, encoded, n, bit2);
+		memset(&stats, 0, sizeof(stats));
+		numErrors = s4642286_lib_hamming_ext_buffer_decode(m, encoded, decoded, length, NULL, &stats);
+		if (numErrors != 1 || stats.doubleErrors != 1) {
+			snprintf(what, sizeof(what), "m %d length %d: double bit error in codeword %d", m, length, n);
+			fail(what);
+		}
+	}
+}
+
+int main(void) {
+	unsigned char buffer[4] = { 0 };
+	char what[128];
+	int m, selftest;
+
+	for (m = HAMMING_EXT_M_MIN; m <= HAMMING_EXT_M_MAX; m++) {
+		selftest = s4642286_lib_hamming_ext_selftest(m);
+		if (selftest != 0) {
+			snprintf(what, sizeof(what), "m %d: self test reported %d failures", m, selftest);
+			fail(what);
+		}
+		test_buffers(m);
+		printf("(%d,%d): checked\n", HAMMING_EXT_N(m), HAMMING_EXT_K(m));
+	}
+
+	// Invalid code sizes.
+	for (m = HAMMING_EXT_M_MIN - 1; m <= HAMMING_EXT_M_MAX + 1; m += HAMMING_EXT_M_MAX - HAMMING_EXT_M_MIN + 2) {
+		if (s4642286_lib_hamming_ext_encode(m, 1) != 0 ||
+				s4642286_lib_hamming_ext_buffer_encode(m, buffer, buffer, 1) != -1 ||
+				s4642286_lib_hamming_ext_buffer_decode(m, buffer, buffer, 1, NULL, NULL) != -1 ||
+				s4642286_lib_hamming_ext_selftest(m) == 0) {
+			snprintf(what, sizeof(what), "m %d not rejected", m);
+			fail(what);
+		}
+	}
+
+	printf("%s (%d failures)\n", failures ? "FAILED" : "PASSED", failures);
+	return failures != 0;
+}
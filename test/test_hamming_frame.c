@@ -0,0 +1,263 @@
+ /**
+ **************************************************************
+ * @file test/test_hamming_frame.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host tests for the interleaved Hamming framing
+ ***************************************************************
+ * Usage:
+ *   test_hamming_frame [frames]
+ *
+ * 1. CRC: one word must give the STM32 CRC unit's value for 0x12345678
+ *    (0xDF8A8A2B), and a frame's CRC (length word, then payload) must match
+ *    CRC-32/MPEG-2 over the same bytes.
+ * 2. Bursts: random frames (random payload lengths) are sent through the
+ *    decoder byte by byte, with random noise between them and one burst of
+ *    1 to HAMMING_FRAME_BURST_BITS bits (UART order, LSB first) in the
+ *    blocks. Every frame must be received with its payload, and the
+ *    corrected count must match the bits flipped.
+ * 3. Unprotected header: a burst over SYNC and LEN may drop the frame, but
+ *    must never deliver a wrong payload. The decoder is then reset, as the
+ *    receiver would on an idle link.
+ * 4. Errors: a bad length, a double bit error and a CRC mismatch must each
+ *    be reported, and the decoder must then receive the next frame.
+ ***************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The CRC is private to the framing module.
+#include "../mylib/s4642286_hamming_frame.c"
+
+// Default number of frames in the burst tests.
+#define TEST_FRAMES 20000
+
+// Largest frame.
+#define MAX_FRAME HAMMING_FRAME_SIZE(HAMMING_FRAME_MAX_PAYLOAD)
+
+static int failures;
+
+static unsigned int randomState = 0x3010;
+
+/**
+ * @brief Reports a failed check.
+ *
+ * @param what description of the check.
+ */
+static void fail(const char *what) {
+	printf("FAIL: %s\n", what);
+	failures++;
+}
+
+/*
+ * xorshift32, so runs are repeatable.
+ */
+static unsigned int random_next(void) {
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+/*
+ * Flip bits of a frame, numbered in UART order (bit 0 is the LSB of byte 0).
+ */
+static void flip_bit(unsigned char *frame, int bit) {
+	frame[bit / 8] ^= 1 << (bit % 8);
+}
+
+/*
+ * Flip a burst of length bits starting at bit start: the first and last bit
+ * are always flipped, the bits between them at random.
+ * Returns the number of bits flipped.
+ */
+static int flip_burst(unsigned char *frame, int start, int length) {
+	int i, flipped = 0;
+
+	for (i = 0; i < length; i++) {
+		if (i == 0 || i == length - 1 || (random_next() & 1)) {
+			flip_bit(frame, start + i);
+			flipped++;
+		}
+	}
+	return flipped;
+}
+
+/*
+ * Feed bytes to the decoder. Returns the last non busy status, or
+ * HAMMING_FRAME_BUSY if there was none, and counts the frames received.
+ */
+static int feed(hammingFrameDecoder_t *decoder, const unsigned char *data, int size, int *received) {
+	int i, status, last = HAMMING_FRAME_BUSY;
+
+	for (i = 0; i < size; i++) {
+		status = s4642286_lib_hamming_frame_decode_byte(decoder, data[i]);
+		if (status != HAMMING_FRAME_BUSY) {
+			last = status;
+		}
+		if (status == HAMMING_FRAME_READY) {
+			(*received)++;
+		}
+	}
+	return last;
+}
+
+/**
+ * @brief Checks the CRC against known values.
+ *
+ */
+static void test_crc(void) {
+	static const unsigned char word[4] = { 0x78, 0x56, 0x34, 0x12 };
+
+	// One word through the STM32 CRC unit (CRC->DR = 0x12345678).
+	if (frame_crc_word(0xFFFFFFFF, 0x12345678) != 0xDF8A8A2B) {
+		fail("CRC of 0x12345678");
+	}
+
+	// A frame's CRC covers its length first: CRC-32/MPEG-2 of 00 00 00 04 12 34 56 78.
+	if (frame_crc(word, 4) != 0x517E6F8A) {
+		fail("frame CRC of 0x12345678");
+	}
+}
+
+/**
+ * @brief Sends random frames with bursts in the blocks and in the header.
+ *
+ * @param frames the number of frames.
+ */
+static void test_bursts(long frames) {
+	unsigned char payload[HAMMING_FRAME_MAX_PAYLOAD], frame[MAX_FRAME], noise[16];
+	hammingFrameDecoder_t decoder;
+	char what[128];
+	long f;
+	int length, size, i, start, burst, flipped, received, status, header;
+	long headerDropped = 0;
+
+	s4642286_lib_hamming_frame_decoder_init(&decoder);
+
+	for (f = 0; f < frames; f++) {
+		length = random_next() % (HAMMING_FRAME_MAX_PAYLOAD + 1);
+		for (i = 0; i < length; i++) {
+			payload[i] = random_next();
+		}
+
+		size = s4642286_lib_hamming_frame_encode(payload, length, frame, sizeof(frame));
+		if (size != HAMMING_FRAME_SIZE(length)) {
+			snprintf(what, sizeof(what), "frame size for length %d", length);
+			fail(what);
+			continue;
+		}
+
+		// Noise between frames (never SYNC0), which the decoder must skip.
+		for (i = 0; i < (int) sizeof(noise); i++) {
+			do {
+				noise[i] = random_next();
+			} while (noise[i] == HAMMING_FRAME_SYNC0);
+		}
+		received = 0;
+		feed(&decoder, noise, random_next() % sizeof(noise), &received);
+
+		// One frame in 8 has its burst over the header instead.
+		header = (f % 8) == 7;
+		burst = 1 + random_next() % HAMMING_FRAME_BURST_BITS;
+		if (header) {
+			start = random_next() % (4 * 8);
+		} else {
+			start = 4 * 8 + random_next() % ((size - 4) * 8 - burst + 1);
+		}
+		flipped = flip_burst(frame, start, burst);
+
+		received = 0;
+		status = feed(&decoder, frame, size, &received);
+
+		if (header) {
+			// The frame may be lost, but a received frame must be right.
+			if (received == 1 && (decoder.length != length || memcmp(decoder.payload, payload, length) != 0)) {
+				snprintf(what, sizeof(what), "frame %ld delivered a wrong payload after a header burst", f);
+				fail(what);
+			}
+			headerDropped += (received == 0);
+
+			// A longer LEN leaves the decoder inside the frame.
+			s4642286_lib_hamming_frame_decoder_init(&decoder);
+		} else if (status != HAMMING_FRAME_READY || received != 1 || decoder.length != length ||
+				memcmp(decoder.payload, payload, length) != 0 || decoder.corrected != (unsigned long) flipped) {
+			snprintf(what, sizeof(what), "frame %ld (length %d, %d bit burst at bit %d): status %d, corrected %lu",
+				f, length, burst, start, status, decoder.corrected);
+			fail(what);
+		}
+	}
+
+	printf("bursts: %ld frames, %ld of %ld header bursts dropped the frame\n", frames, headerDropped, frames / 8);
+}
+
+/**
+ * @brief Checks the error returns and that the decoder recovers after each.
+ *
+ */
+static void test_errors(void) {
+	unsigned char payload[12] = "hamming test", other[12] = "HAMMING TEST";
+	unsigned char frame[MAX_FRAME], spliced[MAX_FRAME], good[MAX_FRAME];
+	hammingFrameDecoder_t decoder;
+	unsigned short encodedLength;
+	int size, goodSize, received;
+
+	s4642286_lib_hamming_frame_decoder_init(&decoder);
+	goodSize = s4642286_lib_hamming_frame_encode(payload, sizeof(payload), good, sizeof(good));
+
+	// Encoding checks its arguments.
+	if (s4642286_lib_hamming_frame_encode(payload, -1, frame, sizeof(frame)) != -1 ||
+			s4642286_lib_hamming_frame_encode(payload, HAMMING_FRAME_MAX_PAYLOAD + 1, frame, sizeof(frame)) != -1 ||
+			s4642286_lib_hamming_frame_encode(payload, sizeof(payload), frame, goodSize - 1) != -1) {
+		fail("encode argument checks");
+	}
+
+	// Length above HAMMING_FRAME_MAX_PAYLOAD.
+	size = s4642286_lib_hamming_frame_encode(payload, sizeof(payload), frame, sizeof(frame));
+	encodedLength = s4642286_lib_hamming_byte_encode(HAMMING_FRAME_MAX_PAYLOAD + 1);
+	frame[2] = encodedLength & 0xFF;
+	frame[3] = encodedLength >> 8;
+	received = 0;
+	if (feed(&decoder, frame, 4, &received) != HAMMING_FRAME_ERROR_LENGTH) {
+		fail("length error");
+	}
+
+	// Two bit errors in one codeword (both in the first block's first byte).
+	size = s4642286_lib_hamming_frame_encode(payload, sizeof(payload), frame, sizeof(frame));
+	flip_bit(frame, 4 * 8);
+	flip_bit(frame, 5 * 8);
+	if (feed(&decoder, frame, size, &received) != HAMMING_FRAME_ERROR_UNCORRECTABLE) {
+		fail("uncorrectable error");
+	}
+
+	// Blocks of one payload with the CRC block of another.
+	size = s4642286_lib_hamming_frame_encode(other, sizeof(other), spliced, sizeof(spliced));
+	memcpy(spliced + size - 8, good + goodSize - 8, 8);
+	if (feed(&decoder, spliced, size, &received) != HAMMING_FRAME_ERROR_CRC) {
+		fail("CRC error");
+	}
+
+	// The decoder must still receive a good frame.
+	if (feed(&decoder, good, goodSize, &received) != HAMMING_FRAME_READY || received != 1 ||
+			memcmp(decoder.payload, payload, sizeof(payload)) != 0) {
+		fail("frame after errors");
+	}
+}
+
+int main(int argc, char **argv) {
+	long frames = (argc > 1) ? atol(argv[1]) : TEST_FRAMES;
+
+	if (frames <= 0) {
+		fprintf(stderr, "usage: %s [frames]\n", argv[0]);
+		return 2;
+	}
+
+	test_crc();
+	test_bursts(frames);
+	test_errors();
+
+	printf("%s (%d failures)\n", failures ? "FAILED" : "PASSED", failures);
+	return failures != 0;
+}
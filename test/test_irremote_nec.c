@@ -0,0 +1,518 @@
+ /**
+ **************************************************************
+ * @file test/test_irremote_nec.c
+ * @author Ethan Pinto - 46422860
+ * @date 19/10/2026
+ * @brief Host harness for the NEC decoder
+ ***************************************************************
+ * Usage:
+ *   test_irremote_nec [transmissions per scenario] [timing edges]
+ *
+ * 1. Accuracy: synthetic receiver traces (the falling edge times that the
+ *    TIM2 capture would record) are fed to s4642286_irremote_nec_edge().
+ *    Each transmission is a random valid frame followed by 0 to 3 repeat
+ *    codes, with random gaps, starting just before the 32 bit counter wraps.
+ *    The scenarios add edge jitter, clock skew, glitches (extra edges) and
+ *    dropped edges, and the report gives decoded, missed and false frames
+ *    and repeats for each. Traces within the decoder's tolerance (clean,
+ *    100us jitter, 5% skew) must decode perfectly, and no scenario may produce a
+ *    frame that was not sent.
+ * 2. Timing: a long clean trace is decoded in a loop, and the mean time per
+ *    edge is reported in ns (and in TSC cycles on x86). Each edge is then
+ *    timed on its own from the decoder state before it (fastest of repeated
+ *    calls, so host interrupts drop out), and the slowest edge gives the
+ *    worst case cost of one call, which is the ISR's decode work on the
+ *    target. The timer's own overhead is taken off.
+ ***************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "s4642286_irremote_nec.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+// Default transmissions per accuracy scenario, and edges in the timing trace.
+#define TRANSMISSIONS 2000
+#define TIMING_EDGES 2000000
+
+// Calls per edge when a slow single edge is timed again.
+#define RETIME_CALLS 100
+
+// NEC timings (us): interval between the falling edges of each symbol.
+#define NEC_LEADER_US 13500.0
+#define NEC_REPEAT_US 11250.0
+#define NEC_BIT0_US 1125.0
+#define NEC_BIT1_US 2250.0
+#define NEC_FRAME_PERIOD_US 108000.0	// Frame start to repeat start
+
+// Expected element types.
+#define ELEMENT_FRAME 0
+#define ELEMENT_REPEAT 1
+
+/**
+ * @brief A struct for the noise added to a trace.
+ *
+ */
+typedef struct {
+	const char *name;
+	double jitter;          // Each edge moves by up to +-jitter us
+	double skew;            // Transmitter clock error (0.05 is 5% slow)
+	double glitch;          // Chance of an extra edge in each interval
+	double drop;            // Chance of losing each edge
+	int mustBePerfect;      // 1 if every frame and repeat must decode
+} scenario_t;
+
+static const scenario_t scenarios[] = {
+	{ "clean", 0, 0, 0, 0, 1 },
+	{ "jitter 100us", 100, 0, 0, 0, 1 },
+	{ "jitter 150us", 150, 0, 0, 0, 0 },    // Past the +-225us bit 0 margin
+	{ "skew -5%", 50, -0.05, 0, 0, 1 },
+	{ "skew +5%", 50, 0.05, 0, 0, 1 },
+	{ "glitch 0.5%", 50, 0, 0.005, 0, 0 },
+	{ "drop 0.5%", 50, 0, 0, 0.005, 0 },
+	{ "noisy", 100, 0.03, 0.01, 0.01, 0 }
+};
+#define NUM_SCENARIOS ((int) (sizeof(scenarios) / sizeof(scenarios[0])))
+
+/**
+ * @brief A struct for one sent frame or repeat code.
+ *
+ */
+typedef struct {
+	int type;           // ELEMENT_FRAME or ELEMENT_REPEAT
+	uint32_t code;      // Frame (also the code a repeat stands for)
+} element_t;
+
+/**
+ * @brief A struct for a trace: edge times and the element each belongs to.
+ *
+ */
+typedef struct {
+	uint32_t *edges;
+	int *owner;
+	int numEdges, maxEdges;
+	element_t *elements;
+	int numElements, maxElements;
+} trace_t;
+
+/**
+ * @brief A struct for the accuracy counts of one scenario.
+ *
+ */
+typedef struct {
+	int frames, framesDecoded, falseFrames;
+	int repeats, repeatsDecoded, falseRepeats;
+} accuracy_t;
+
+static int failures;
+
+static uint32_t randomState = 0x3010;
+
+/**
+ * @brief Reports a failed check.
+ *
+ * @param what description of the check.
+ */
+static void fail(const char *what) {
+	printf("FAIL: %s\n", what);
+	failures++;
+}
+
+/*
+ * xorshift32, so runs are repeatable.
+ */
+static uint32_t random_next(void) {
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+/*
+ * realloc that stops the harness if memory runs out (ptr NULL is malloc).
+ */
+static void *checked_realloc(void *ptr, size_t size) {
+	ptr = realloc(ptr, size);
+	if (ptr == NULL) {
+		fprintf(stderr, "out of memory (%lu bytes)\n", (unsigned long) size);
+		exit(2);
+	}
+	return ptr;
+}
+
+/*
+ * Uniform random number in [0, 1).
+ */
+static double random_unit(void) {
+	return random_next() / 4294967296.0;
+}
+
+/*
+ * Random valid NEC frame (address, ~address, command, ~command).
+ */
+static uint32_t random_frame(void) {
+	uint32_t address = random_next() & 0xFF, command = random_next() & 0xFF;
+
+	return (address << 24) | ((~address & 0xFF) << 16) | (command << 8) | (~command & 0xFF);
+}
+
+/*
+ * Add one edge (time in us since the start of the trace) to the trace.
+ */
+static void trace_edge(trace_t *trace, const scenario_t *scenario, double time, uint32_t start) {
+	if (trace->numEdges == trace->maxEdges) {
+		trace->maxEdges = trace->maxEdges ? 2 * trace->maxEdges : 1024;
+		trace->edges = checked_realloc(trace->edges, trace->maxEdges * sizeof(uint32_t));
+		trace->owner = checked_realloc(trace->owner, trace->maxEdges * sizeof(int));
+	}
+
+	time += scenario->jitter * (2 * random_unit() - 1);
+	trace->edges[trace->numEdges] = start + (uint32_t) (int64_t) time;
+	trace->owner[trace->numEdges] = trace->numElements - 1;
+	trace->numEdges++;
+}
+
+/*
+ * Start a new element of the trace.
+ */
+static void trace_element(trace_t *trace, int type, uint32_t code) {
+	if (trace->numElements == trace->maxElements) {
+		trace->maxElements = trace->maxElements ? 2 * trace->maxElements : 256;
+		trace->elements = checked_realloc(trace->elements, trace->maxElements * sizeof(element_t));
+	}
+	trace->elements[trace->numElements].type = type;
+	trace->elements[trace->numElements].code = code;
+	trace->numElements++;
+}
+
+/**
+ * @brief Builds the edge times of a number of transmissions. The edges are
+ * 		  the starts of the bursts (falling edges of the receiver output).
+ *
+ * @param trace the trace to fill (emptied first).
+ * @param scenario the noise to add.
+ * @param transmissions the number of frames (each with 0 to 3 repeats).
+ * @param start counter value at the start of the trace.
+ */
+static void trace_build(trace_t *trace, const scenario_t *scenario, int transmissions, uint32_t start) {
+	double scale = 1 + scenario->skew;
+	double time = 0, frameStart, interval;
+	uint32_t code;
+	int t, r, repeats, bit, i, kept;
+
+	trace->numEdges = 0;
+	trace->numElements = 0;
+
+	for (t = 0; t < transmissions; t++) {
+		// Frame: leader, 32 bits (MSB first), then the stop burst.
+		code = random_frame();
+		trace_element(trace, ELEMENT_FRAME, code);
+		frameStart = time;
+		trace_edge(trace, scenario, time, start);
+		time += NEC_LEADER_US * scale;
+		trace_edge(trace, scenario, time, start);
+		for (bit = 31; bit >= 0; bit--) {
+			time += (((code >> bit) & 0x01) ? NEC_BIT1_US : NEC_BIT0_US) * scale;
+			trace_edge(trace, scenario, time, start);
+		}
+
+		// Repeat codes every 108ms while the button is held.
+		repeats = random_next() % 4;
+		for (r = 1; r <= repeats; r++) {
+			trace_element(trace, ELEMENT_REPEAT, code);
+			time = frameStart + r * NEC_FRAME_PERIOD_US * scale;
+			trace_edge(trace, scenario, time, start);
+			time += NEC_REPEAT_US * scale;
+			trace_edge(trace, scenario, time, start);
+		}
+
+		// The button is released for 40ms to 150ms.
+		time += 40000 + random_next() % 110000;
+	}
+
+	// Dropped edges, and glitches (an extra edge somewhere in an interval).
+	if (scenario->glitch > 0 || scenario->drop > 0) {
+		uint32_t *edges = checked_realloc(NULL, 2 * trace->numEdges * sizeof(uint32_t));
+		int *owner = checked_realloc(NULL, 2 * trace->numEdges * sizeof(int));
+
+		kept = 0;
+		for (i = 0; i < trace->numEdges; i++) {
+			if (random_unit() >= scenario->drop) {
+				edges[kept] = trace->edges[i];
+				owner[kept++] = trace->owner[i];
+			}
+
+			if (i + 1 < trace->numEdges && random_unit() < scenario->glitch) {
+				interval = (double) (uint32_t) (trace->edges[i + 1] - trace->edges[i]);
+				edges[kept] = trace->edges[i] + (uint32_t) (interval * (0.1 + 0.8 * random_unit()));
+				owner[kept++] = trace->owner[i];
+			}
+		}
+
+		free(trace->edges);
+		free(trace->owner);
+		trace->edges = edges;
+		trace->owner = owner;
+		trace->maxEdges = 2 * trace->numEdges;
+		trace->numEdges = kept;
+	}
+}
+
+/**
+ * @brief Decodes a trace and counts the results against the sent elements.
+ *
+ * @param trace the trace.
+ * @param accuracy receives the counts.
+ */
+static void trace_decode(const trace_t *trace, accuracy_t *accuracy) {
+	necDecoder_t decoder;
+	uint32_t code;
+	char *decoded = checked_realloc(NULL, trace->numElements + 1);
+	const element_t *element;
+	int i, result;
+
+	memset(decoded, 0, trace->numElements + 1);
+	memset(accuracy, 0, sizeof(*accuracy));
+	s4642286_irremote_nec_init(&decoder);
+
+	for (i = 0; i < trace->numEdges; i++) {
+		result = s4642286_irremote_nec_edge(&decoder, trace->edges[i], &code);
+		if (result == NEC_NONE) {
+			continue;
+		}
+
+		// Results belong to the element whose edge completed them.
+		element = &trace->elements[trace->owner[i]];
+		if (result == NEC_FRAME) {
+			if (element->type == ELEMENT_FRAME && code == element->code && !decoded[trace->owner[i]]) {
+				decoded[trace->owner[i]] = 1;
+				accuracy->framesDecoded++;
+			} else {
+				accuracy->falseFrames++;
+			}
+		} else {
+			if (element->type == ELEMENT_REPEAT && code == element->code && !decoded[trace->owner[i]]) {
+				decoded[trace->owner[i]] = 1;
+				accuracy->repeatsDecoded++;
+			} else {
+				accuracy->falseRepeats++;
+			}
+		}
+	}
+
+	for (i = 0; i < trace->numElements; i++) {
+		if (trace->elements[i].type == ELEMENT_FRAME) {
+			accuracy->frames++;
+		} else {
+			accuracy->repeats++;
+		}
+	}
+
+	free(decoded);
+}
+
+/**
+ * @brief Runs every scenario and prints the accuracy report.
+ *
+ * @param transmissions transmissions per scenario.
+ */
+static void test_accuracy(int transmissions) {
+	trace_t trace;
+	accuracy_t accuracy;
+	char what[100];
+	int s;
+
+	memset(&trace, 0, sizeof(trace));
+
+	printf("accuracy, %d transmissions per scenario:\n", transmissions);
+	printf("  %-14s %7s %7s %6s %6s  %7s %7s %6s %6s\n", "scenario", "frames", "decoded", "missed", "false",
+		"repeats", "decoded", "missed", "false");
+
+	for (s = 0; s < NUM_SCENARIOS; s++) {
+		// Start 10s before the 32 bit us counter wraps.
+		trace_build(&trace, &scenarios[s], transmissions, 0xFFFFFFFFu - 10000000u);
+		trace_decode(&trace, &accuracy);
+
+		printf("  %-14s %7d %6.2f%% %6d %6d  %7d %6.2f%% %6d %6d\n", scenarios[s].name,
+			accuracy.frames, 100.0 * accuracy.framesDecoded / accuracy.frames,
+			accuracy.frames - accuracy.framesDecoded, accuracy.falseFrames,
+			accuracy.repeats, accuracy.repeats ? 100.0 * accuracy.repeatsDecoded / accuracy.repeats : 100.0,
+			accuracy.repeats - accuracy.repeatsDecoded, accuracy.falseRepeats);
+
+		if (scenarios[s].mustBePerfect && (accuracy.framesDecoded != accuracy.frames ||
+				accuracy.repeatsDecoded != accuracy.repeats || accuracy.falseRepeats != 0)) {
+			snprintf(what, sizeof(what), "%s: trace within tolerance not fully decoded", scenarios[s].name);
+			fail(what);
+		}
+		if (accuracy.falseFrames != 0) {
+			snprintf(what, sizeof(what), "%s: decoded a frame that was not sent", scenarios[s].name);
+			fail(what);
+		}
+	}
+
+	free(trace.edges);
+	free(trace.owner);
+	free(trace.elements);
+}
+
+/*
+ * Nanoseconds since an arbitrary point.
+ */
+static double now_ns(void) {
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+/*
+ * Smallest time between two back to back now_ns() calls, which is taken off
+ * each single edge time.
+ */
+static double timer_overhead(void) {
+	double start, elapsed, best = 1e30;
+	int i;
+
+	for (i = 0; i < 10000; i++) {
+		start = now_ns();
+		elapsed = now_ns() - start;
+		best = elapsed < best ? elapsed : best;
+	}
+	return best;
+}
+
+/*
+ * Time of one decoder call from a saved state: the fastest of repeats calls,
+ * less the timer overhead. The saved state is not changed.
+ */
+static double edge_time(const necDecoder_t *state, uint32_t edge, int repeats, double overhead, int *result) {
+	necDecoder_t decoder;
+	uint32_t code;
+	double start, elapsed, best = 1e30;
+	int r;
+
+	for (r = 0; r < repeats; r++) {
+		decoder = *state;
+		start = now_ns();
+		*result = s4642286_irremote_nec_edge(&decoder, edge, &code);
+		elapsed = now_ns() - start;
+		best = elapsed < best ? elapsed : best;
+	}
+	return best > overhead ? best - overhead : 0;
+}
+
+/**
+ * @brief Measures the decoder's time per edge on a long clean trace: the mean
+ * 		  over the whole trace, and the worst single edge.
+ *
+ * @param edges the approximate number of edges to decode.
+ */
+static void test_timing(int edges) {
+	static const char * const results[] = { "no result", "frame", "repeat" };
+	trace_t trace;
+	necDecoder_t decoder;
+	uint32_t code, sink = 0;
+	double start, best = 1e30, elapsed, overhead, threshold, *fastest;
+	int pass, i, result, worst;
+	unsigned char *edgeResult, *retimed;
+#ifdef HAVE_TSC
+	unsigned long long cycles, bestCycles = ~0ULL;
+#endif
+
+	memset(&trace, 0, sizeof(trace));
+	trace_build(&trace, &scenarios[0], edges / 40 + 1, 0);
+
+	for (pass = 0; pass < 5; pass++) {
+		s4642286_irremote_nec_init(&decoder);
+		start = now_ns();
+#ifdef HAVE_TSC
+		cycles = __rdtsc();
+#endif
+		for (i = 0; i < trace.numEdges; i++) {
+			if (s4642286_irremote_nec_edge(&decoder, trace.edges[i], &code) != NEC_NONE) {
+				sink += code;
+			}
+		}
+#ifdef HAVE_TSC
+		cycles = __rdtsc() - cycles;
+		bestCycles = cycles < bestCycles ? cycles : bestCycles;
+#endif
+		elapsed = now_ns() - start;
+		best = elapsed < best ? elapsed : best;
+	}
+
+	printf("timing, %d edges, best of 5: %.2f ns/edge", trace.numEdges, best / trace.numEdges);
+#ifdef HAVE_TSC
+	printf(", %.1f TSC cycles/edge", (double) bestCycles / trace.numEdges);
+#endif
+	printf(" (checksum %08x)\n", (unsigned int) sink);
+
+	/* Each edge on its own, from the decoder state before it. A host
+	 * interrupt can land on every one of a few calls, so the slowest edges
+	 * are timed again with many more calls until the slowest edge is one of
+	 * them (a time can only be too high, never too low). */
+	fastest = checked_realloc(NULL, trace.numEdges * sizeof(double));
+	edgeResult = checked_realloc(NULL, trace.numEdges);
+	retimed = checked_realloc(NULL, trace.numEdges);
+	memset(retimed, 0, trace.numEdges);
+	overhead = timer_overhead();
+	threshold = 0;
+
+	for (;;) {
+		s4642286_irremote_nec_init(&decoder);
+		for (i = 0; i < trace.numEdges; i++) {
+			if (threshold == 0) {
+				fastest[i] = edge_time(&decoder, trace.edges[i], 5, overhead, &result);
+				edgeResult[i] = result;
+			} else if (!retimed[i] && fastest[i] >= threshold) {
+				fastest[i] = edge_time(&decoder, trace.edges[i], RETIME_CALLS, overhead, &result);
+				retimed[i] = 1;
+			}
+			s4642286_irremote_nec_edge(&decoder, trace.edges[i], &code);
+		}
+
+		worst = 0;
+		for (i = 1; i < trace.numEdges; i++) {
+			if (fastest[i] > fastest[worst]) {
+				worst = i;
+			}
+		}
+		if (retimed[worst] || fastest[worst] <= 0) {
+			break;
+		}
+		threshold = fastest[worst] / 2;
+	}
+
+	printf("worst edge: %.0f ns (edge %d, %s), %.0f ns timer overhead removed\n",
+		fastest[worst], worst, results[edgeResult[worst]], overhead);
+
+	free(fastest);
+	free(edgeResult);
+	free(retimed);
+	free(trace.edges);
+	free(trace.owner);
+	free(trace.elements);
+}
+
+int main(int argc, char **argv) {
+	int transmissions = (argc > 1) ? atoi(argv[1]) : TRANSMISSIONS;
+	int edges = (argc > 2) ? atoi(argv[2]) : TIMING_EDGES;
+
+	if (transmissions <= 0 || edges <= 0) {
+		fprintf(stderr, "usage: %s [transmissions per scenario] [timing edges]\n", argv[0]);
+		return 2;
+	}
+
+	test_accuracy(transmissions);
+	test_timing(edges);
+
+	printf("%s (%d failures)\n", failures ? "FAILED" : "PASSED", failures);
+	return failures != 0;
+}